@@ -69,7 +69,7 @@ MessagesSearch::MessagesSearch(not_null<History*> history)
 }
 
 MessagesSearch::~MessagesSearch() {
-	_history->session().sender().request(_requestId).cancel();
+	cancelRequests();
 #if 0 // mtp
 	_history->owner().histories().cancelRequest(
 		base::take(_searchInHistoryRequest));
@@ -77,23 +77,66 @@ MessagesSearch::~MessagesSearch() {
 }
 
 void MessagesSearch::searchMessages(const QString &query, PeerData *from) {
+	// Results of the previous query are stale now.
+	cancelRequests();
+	_prefetch = false;
 	_query = query;
 	_from = from;
 	_offsetId = {};
 	_full = false;
+	_searchStarted = crl::now();
+	_moreRequested = 0;
 	searchRequest();
 }
 
 void MessagesSearch::searchMore() {
-	if (_searchInHistoryRequest || _requestId || _full) {
+	if (_searchInHistoryRequest
+		|| _requestId
+		|| _waitingForPrefetch
+		|| _full) {
 		return;
 	}
-	searchRequest();
+	_prefetch = true;
+	_moreRequested = crl::now();
+	if (_prefetched && _prefetchedOffsetId == _offsetId) {
+		const auto result = base::take(_prefetched);
+		searchReceived(*result, _requestId, currentToken());
+	} else if (_prefetchRequestId) {
+		_waitingForPrefetch = true;
+	} else {
+		_prefetched = nullptr;
+		searchRequest();
+	}
+}
+
+void MessagesSearch::cancelRequests() {
+	auto &sender = _history->session().sender();
+	sender.request(base::take(_requestId)).cancel();
+	sender.request(base::take(_prefetchRequestId)).cancel();
+	_prefetched = nullptr;
+	_waitingForPrefetch = false;
+}
+
+QString MessagesSearch::currentToken() const {
+	return _query + QString::number(_from ? _from->id.value : 0);
+}
+
+TLsearchChatMessages MessagesSearch::pageQuery(MsgId offsetId) const {
+	return TLsearchChatMessages(
+		peerToTdbChat(_history->peer->id),
+		tl_string(_query),
+		(_from
+			? peerToSender(_from->id)
+			: std::optional<TLmessageSender>()),
+		tl_int53(offsetId.bare), // from_message_id
+		tl_int32(0), // offset
+		tl_int32(kSearchPerPage),
+		std::nullopt, // filter
+		tl_int53(0)); // message_thread_id
 }
 
 void MessagesSearch::searchRequest() {
-	const auto nextToken = _query
-		+ QString::number(_from ? _from->id.value : 0);
+	const auto nextToken = currentToken();
 	if (!_offsetId) {
 		const auto it = _cacheOfStartByToken.find(nextToken);
 		if (it != end(_cacheOfStartByToken)) {
@@ -105,18 +148,9 @@ void MessagesSearch::searchRequest() {
 	if (_requestId) {
 		_history->session().sender().request(_requestId).cancel();
 	}
-	_requestId = _history->session().sender().request(TLsearchChatMessages(
-		peerToTdbChat(_history->peer->id),
-		tl_string(_query),
-		(_from
-			? peerToSender(_from->id)
-			: std::optional<TLmessageSender>()),
-		tl_int53(_offsetId.bare), // from_message_id
-		tl_int32(0), // offset
-		tl_int32(kSearchPerPage),
-		std::nullopt, // filter
-		tl_int53(0) // message_thread_id
-	)).done([=](const TLfoundChatMessages &result, RequestId id) {
+	_requestId = _history->session().sender().request(
+		pageQuery(_offsetId)
+	).done([=](const TLfoundChatMessages &result, RequestId id) {
 		searchReceived(result, id, nextToken);
 	}).fail([=](const Error &error) {
 		_requestId = 0;
@@ -171,6 +205,30 @@ void MessagesSearch::searchRequest() {
 #endif
 }
 
+void MessagesSearch::prefetchRequest() {
+	if (_prefetchRequestId || _full || !_prefetch) {
+		return;
+	}
+	const auto offsetId = _offsetId;
+	_prefetched = nullptr;
+	_prefetchRequestId = _history->session().sender().request(
+		pageQuery(offsetId)
+	).done([=](const TLfoundChatMessages &result) {
+		_prefetchRequestId = 0;
+		if (base::take(_waitingForPrefetch)) {
+			searchReceived(result, _requestId, currentToken());
+		} else {
+			_prefetched = std::make_unique<TLMessages>(result);
+			_prefetchedOffsetId = offsetId;
+		}
+	}).fail([=] {
+		_prefetchRequestId = 0;
+		if (base::take(_waitingForPrefetch)) {
+			searchRequest();
+		}
+	}).send();
+}
+
 void MessagesSearch::searchReceived(
 		const TLMessages &result,
 		mtpRequestId requestId,
@@ -232,10 +290,23 @@ void MessagesSearch::searchReceived(
 	if (!_offsetId) {
 		_cacheOfStartByToken.emplace(nextToken, result);
 	}
+	if (const auto started = base::take(_moreRequested)) {
+		DEBUG_LOG(("Search: Page of %1 in %2 ms."
+			).arg(int(found.messages.size())
+			).arg(crl::now() - started));
+	} else if (const auto started = base::take(_searchStarted)) {
+		DEBUG_LOG(("Search: First page of %1 in %2 ms."
+			).arg(int(found.messages.size())
+			).arg(crl::now() - started));
+	}
 	_requestId = 0;
 	_offsetId = data.vnext_from_message_id().v;
 	_full = !_offsetId;
 	found.full = _full;
+
+	// Request the next page before delivering this one, so that a
+	// searchMore() from the handlers waits for it instead of a new one.
+	prefetchRequest();
 	_messagesFounds.fire(std::move(found));
 }
 
@@ -9,6 +9,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 
 namespace Tdb {
 class TLfoundChatMessages;
+class TLsearchChatMessages;
 } // namespace Tdb
 
 class HistoryItem;
@@ -39,11 +40,15 @@ private:
 	using TLMessages = MTPmessages_Messages;
 #endif
 	using TLMessages = Tdb::TLfoundChatMessages;
+	[[nodiscard]] QString currentToken() const;
+	[[nodiscard]] Tdb::TLsearchChatMessages pageQuery(MsgId offsetId) const;
 	void searchRequest();
 	void searchReceived(
 		const TLMessages &result,
 		mtpRequestId requestId,
 		const QString &nextToken);
+	void prefetchRequest();
+	void cancelRequests();
 
 	const not_null<History*> _history;
 
@@ -56,6 +61,16 @@ private:
 	int _searchInHistoryRequest = 0; // Not real mtpRequestId.
 	mtpRequestId _requestId = 0;
 
+	// Once more pages were asked for the next one is kept requested.
+	std::unique_ptr<TLMessages> _prefetched;
+	MsgId _prefetchedOffsetId;
+	mtpRequestId _prefetchRequestId = 0;
+	bool _prefetch = false;
+	bool _waitingForPrefetch = false;
+
+	crl::time _searchStarted = 0;
+	crl::time _moreRequested = 0;
+
 	bool _full = false;
 
 	rpl::event_stream<FoundMessages> _messagesFounds;
@@ -4031,6 +4031,12 @@ void ApiWrap::sharedMediaDone(
 		return;
 	}
 	const auto got = !parsed.messageIds.empty();
+	if (!topicRootId && parsed.fullCount) {
+		_session->local().setSharedMediaCount(
+			peer->id,
+			type,
+			*parsed.fullCount);
+	}
 	_session->storage().add(Storage::SharedMediaAddSlice(
 		peer->id,
 		topicRootId,
@@ -704,11 +704,6 @@ PaintRoundImageCallback PeerListRow::generatePaintUserpicCallback(
 }
 
 
-auto PeerListRow::generateNameFirstLetters() const
--> const base::flat_set<QChar> & {
-	return peer()->nameFirstLetters();
-}
-
 auto PeerListRow::generateNameWords() const
 -> const base::flat_set<QString> & {
 	return peer()->nameWords();
@@ -1070,29 +1065,11 @@ void PeerListContent::addToSearchIndex(not_null<PeerListRow*> row) {
 	if (row->isSearchResult()) {
 		return;
 	}
-
-	removeFromSearchIndex(row);
-	row->setNameFirstLetters(row->generateNameFirstLetters());
-	for (auto ch : row->nameFirstLetters()) {
-		_searchIndex[ch].push_back(row);
-	}
+	_searchIndex.add(row, row->generateNameWords());
 }
 
 void PeerListContent::removeFromSearchIndex(not_null<PeerListRow*> row) {
-	const auto &nameFirstLetters = row->nameFirstLetters();
-	if (!nameFirstLetters.empty()) {
-		for (auto ch : row->nameFirstLetters()) {
-			auto it = _searchIndex.find(ch);
-			if (it != _searchIndex.cend()) {
-				auto &entry = it->second;
-				entry.erase(ranges::remove(entry, row), end(entry));
-				if (entry.empty()) {
-					_searchIndex.erase(it);
-				}
-			}
-		}
-		row->setNameFirstLetters({});
-	}
+	_searchIndex.remove(row);
 }
 
 void PeerListContent::prependRow(std::unique_ptr<PeerListRow> row) {
@@ -1937,46 +1914,11 @@ void PeerListContent::searchQueryChanged(QString query) {
 		if (_controller->searchInLocal() && !searchWordsList.isEmpty()) {
 			Assert(_hiddenRows.empty());
 
-			auto minimalList = (const std::vector<not_null<PeerListRow*>>*)nullptr;
-			for (const auto &searchWord : searchWordsList) {
-				auto searchWordStart = searchWord[0].toLower();
-				auto it = _searchIndex.find(searchWordStart);
-				if (it == _searchIndex.cend()) {
-					// Some word can't be found in any row.
-					minimalList = nullptr;
-					break;
-				} else if (!minimalList || minimalList->size() > it->second.size()) {
-					minimalList = &it->second;
-				}
-			}
-			if (minimalList) {
-				auto searchWordInNames = [](
-						not_null<PeerListRow*> row,
-						const QString &searchWord) {
-					for (auto &nameWord : row->generateNameWords()) {
-						if (nameWord.startsWith(searchWord)) {
-							return true;
-						}
-					}
-					return false;
-				};
-				auto allSearchWordsInNames = [&](
-						not_null<PeerListRow*> row) {
-					for (const auto &searchWord : searchWordsList) {
-						if (!searchWordInNames(row, searchWord)) {
-							return false;
-						}
-					}
-					return true;
-				};
-
-				_filterResults.reserve(minimalList->size());
-				for (const auto &row : *minimalList) {
-					if (allSearchWordsInNames(row)) {
-						_filterResults.push_back(row);
-					}
-				}
-			}
+			_filterResults = _searchIndex.find(searchWordsList);
+			ranges::sort(_filterResults, ranges::less(), [](
+					not_null<PeerListRow*> row) {
+				return row->absoluteIndex();
+			});
 		}
 		if (_controller->hasComplexSearch()) {
 			_controller->search(_searchQuery);
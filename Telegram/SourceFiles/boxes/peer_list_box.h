@@ -12,6 +12,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "ui/unread_badge.h"
 #include "ui/userpic_view.h"
 #include "ui/layers/box_content.h"
+#include "data/data_search_index.h"
 #include "base/timer.h"
 
 namespace style {
@@ -96,8 +97,6 @@ public:
 	[[nodiscard]] virtual auto generatePaintUserpicCallback(
 		bool forceRound) -> PaintRoundImageCallback;
 
-	[[nodiscard]] virtual auto generateNameFirstLetters() const
-		-> const base::flat_set<QChar> &;
 	[[nodiscard]] virtual auto generateNameWords() const
 		-> const base::flat_set<QString> &;
 
@@ -233,13 +232,6 @@ public:
 		int outerWidth);
 	float64 checkedRatio();
 
-	void setNameFirstLetters(const base::flat_set<QChar> &firstLetters) {
-		_nameFirstLetters = firstLetters;
-	}
-	const base::flat_set<QChar> &nameFirstLetters() const {
-		return _nameFirstLetters;
-	}
-
 	virtual void lazyInitialize(const style::PeerListItem &st);
 	virtual void paintStatusText(
 		Painter &p,
@@ -280,7 +272,6 @@ private:
 	Ui::PeerBadge _bagde;
 	StatusType _statusType = StatusType::Online;
 	crl::time _statusValidTill = 0;
-	base::flat_set<QChar> _nameFirstLetters;
 	QString _savedMessagesStatus;
 	int _absoluteIndex = -1;
 	State _disabledState = State::Active;
@@ -648,9 +639,6 @@ public:
 	template <typename ReorderCallback>
 	void reorderRows(ReorderCallback &&callback) {
 		callback(_rows.begin(), _rows.end());
-		for (auto &searchEntity : _searchIndex) {
-			callback(searchEntity.second.begin(), searchEntity.second.end());
-		}
 		refreshIndices();
 		if (!_hiddenRows.empty()) {
 			callback(_filterResults.begin(), _filterResults.end());
@@ -816,7 +804,7 @@ private:
 	std::map<PeerListRowId, not_null<PeerListRow*>> _rowsById;
 	std::map<PeerData*, std::vector<not_null<PeerListRow*>>> _rowsByPeer;
 
-	std::map<QChar, std::vector<not_null<PeerListRow*>>> _searchIndex;
+	Data::SearchIndex<not_null<PeerListRow*>> _searchIndex;
 	QString _searchQuery;
 	QString _normalizedSearchQuery;
 	QString _mentionHighlight;
@@ -879,11 +879,6 @@ auto ChooseTopicBoxController::Row::generatePaintUserpicCallback(
 	};
 }
 
-auto ChooseTopicBoxController::Row::generateNameFirstLetters() const
--> const base::flat_set<QChar> & {
-	return _topic->chatListFirstLetters();
-}
-
 auto ChooseTopicBoxController::Row::generateNameWords() const
 -> const base::flat_set<QString> & {
 	return _topic->chatListNameWords();
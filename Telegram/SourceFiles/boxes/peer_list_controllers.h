@@ -304,8 +304,6 @@ private:
 		PaintRoundImageCallback generatePaintUserpicCallback(
 			bool forceRound) override;
 
-		auto generateNameFirstLetters() const
-			-> const base::flat_set<QChar> & override;
 		auto generateNameWords() const
 			-> const base::flat_set<QString> & override;
 
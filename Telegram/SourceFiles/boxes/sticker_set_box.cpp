@@ -1175,7 +1175,7 @@ not_null<Lottie::MultiPlayer*> StickerSetBox::Inner::getLottiePlayer() {
 	if (!_lottiePlayer) {
 		_lottiePlayer = std::make_unique<Lottie::MultiPlayer>(
 			Lottie::Quality::Default,
-			Lottie::MakeFrameRenderer());
+			ChatHelpers::LottieRenderer(this));
 		_lottiePlayer->updates(
 		) | rpl::start_with_next([=] {
 			updateItems();
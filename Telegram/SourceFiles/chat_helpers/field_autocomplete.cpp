@@ -1414,7 +1414,7 @@ auto FieldAutocomplete::Inner::getLottieRenderer()
 	if (auto result = _lottieRenderer.lock()) {
 		return result;
 	}
-	auto result = Lottie::MakeFrameRenderer();
+	auto result = ChatHelpers::LottieRenderer(this);
 	_lottieRenderer = result;
 	return result;
 }
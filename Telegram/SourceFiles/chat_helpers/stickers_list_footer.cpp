@@ -1124,7 +1124,7 @@ auto StickersListFooter::getLottieRenderer()
 	if (auto result = _lottieRenderer.lock()) {
 		return result;
 	}
-	auto result = Lottie::MakeFrameRenderer();
+	auto result = LottieRenderer(this);
 	_lottieRenderer = result;
 	return result;
 }
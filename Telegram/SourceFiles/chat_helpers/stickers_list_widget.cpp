@@ -2541,7 +2541,7 @@ auto StickersListWidget::getLottieRenderer()
 	if (auto result = _lottieRenderer.lock()) {
 		return result;
 	}
-	auto result = Lottie::MakeFrameRenderer();
+	auto result = LottieRenderer(this);
 	_lottieRenderer = result;
 	return result;
 }
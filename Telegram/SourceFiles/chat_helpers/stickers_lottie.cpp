@@ -26,8 +26,32 @@ namespace {
 
 constexpr auto kDontCacheLottieAfterArea = 512 * 512;
 
+base::flat_map<
+	not_null<QWidget*>,
+	std::weak_ptr<Lottie::FrameRenderer>> LottieRenderers;
+
 } // namespace
 
+std::shared_ptr<Lottie::FrameRenderer> LottieRenderer(
+		not_null<QWidget*> surface) {
+	for (auto i = begin(LottieRenderers); i != end(LottieRenderers);) {
+		if (i->second.expired()) {
+			i = LottieRenderers.erase(i);
+		} else {
+			++i;
+		}
+	}
+	auto &weak = LottieRenderers[surface->window()];
+	if (auto result = weak.lock()) {
+		return result;
+	}
+	auto result = Lottie::MakeFrameRenderer();
+	weak = result;
+	DEBUG_LOG(("Lottie: Created window renderer, %1 in total."
+		).arg(LottieRenderers.size()));
+	return result;
+}
+
 uint8 LottieCacheKeyShift(uint8 replacementsTag, StickerLottieSize sizeTag) {
 	return ((replacementsTag << 4) & 0xF0) | (uint8(sizeTag) & 0x0F);
 }
@@ -70,6 +70,11 @@ enum class StickerLottieSize : uint8 {
 	uint8 replacementsTag,
 	StickerLottieSize sizeTag);
 
+// Each frame renderer owns a rendering thread, so all the surfaces
+// of a window share one.
+[[nodiscard]] std::shared_ptr<Lottie::FrameRenderer> LottieRenderer(
+	not_null<QWidget*> surface);
+
 [[nodiscard]] std::unique_ptr<Lottie::SinglePlayer> LottiePlayerFromDocument(
 	not_null<Data::DocumentMedia*> media,
 	StickerLottieSize sizeTag,
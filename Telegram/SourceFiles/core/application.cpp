@@ -22,6 +22,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "base/timer.h"
 #include "base/unixtime.h"
 #include "core/core_settings.h"
+#include "core/core_tracing.h"
 #include "core/update_checker.h"
 #include "core/shortcuts.h"
 #include "core/sandbox.h"
@@ -247,6 +248,8 @@ Application::~Application() {
 }
 
 void Application::run() {
+	const auto span = TraceSpan("startup", "Application::run");
+
 	style::internal::StartFonts();
 
 	ThirdParty::start();
@@ -0,0 +1,237 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "core/core_tracing.h"
+
+#include "tdb/tdb_sender.h"
+
+#include <QtCore/QMutex>
+#include <QtCore/QFile>
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+
+namespace Core {
+namespace details {
+
+std::atomic<bool> TracingEnabledValue = false;
+
+} // namespace details
+namespace {
+
+constexpr auto kEventsLimit = 1 << 20;
+constexpr auto kEventsReserve = 1 << 14;
+constexpr auto kRequestIdBits = 48;
+
+struct Event {
+	const char *category = nullptr;
+	const char *name = nullptr;
+	crl::profile_time timestamp = 0;
+	crl::profile_time duration = 0;
+	uint64 id = 0;
+	int64 value = 0;
+	int thread = 0;
+	char phase = 0;
+};
+
+struct Collector {
+	QMutex mutex;
+	std::vector<Event> events;
+	int startedThread = 0;
+	int dropped = 0;
+};
+
+[[nodiscard]] Collector &Instance() {
+	static auto result = Collector();
+	return result;
+}
+
+[[nodiscard]] int CurrentThread() {
+	static auto counter = std::atomic<int>();
+	thread_local const auto result = ++counter;
+	return result;
+}
+
+void Record(Event &&event) {
+	event.thread = CurrentThread();
+
+	auto &collector = Instance();
+	QMutexLocker lock(&collector.mutex);
+	if (int(collector.events.size()) >= kEventsLimit) {
+		++collector.dropped;
+	} else {
+		collector.events.push_back(std::move(event));
+	}
+}
+
+void AppendEvent(QByteArray &result, const Event &event) {
+	result.append("{\"cat\":\"").append(event.category);
+	result.append("\",\"name\":\"").append(event.name);
+	result.append("\",\"ph\":\"").append(event.phase);
+	result.append("\",\"ts\":").append(QByteArray::number(event.timestamp));
+	if (event.phase == 'X') {
+		result.append(",\"dur\":").append(
+			QByteArray::number(event.duration));
+	} else {
+		result.append(",\"id\":").append(QByteArray::number(event.id));
+	}
+	result.append(",\"pid\":1,\"tid\":").append(
+		QByteArray::number(event.thread));
+	if (event.value) {
+		result.append(",\"args\":{\"value\":").append(
+			QByteArray::number(event.value)).append('}');
+	}
+	result.append('}');
+}
+
+[[nodiscard]] QByteArray Serialize(
+		const std::vector<Event> &events,
+		int startedThread) {
+	auto result = QByteArray();
+	result.reserve(64 + int(events.size()) * 128);
+	result.append("{\"traceEvents\":[");
+	result.append("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":");
+	result.append(QByteArray::number(startedThread));
+	result.append(",\"args\":{\"name\":\"main\"}}");
+	for (const auto &event : events) {
+		result.append(",\n");
+		AppendEvent(result, event);
+	}
+	result.append("],\"displayTimeUnit\":\"ms\"}\n");
+	return result;
+}
+
+// Request ids are allocated by each instance, so the instance is a part
+// of the async span id to keep requests of different accounts apart.
+[[nodiscard]] uint64 RequestTraceId(
+		not_null<Tdb::details::Instance*> instance,
+		Tdb::RequestId requestId) {
+	static auto indices = base::flat_map<
+		not_null<Tdb::details::Instance*>,
+		uint64>();
+	const auto i = indices.emplace(
+		instance,
+		uint64(indices.size() + 1)).first;
+	constexpr auto kMask = (uint64(1) << kRequestIdBits) - 1;
+	return (i->second << kRequestIdBits) | (uint64(requestId) & kMask);
+}
+
+void RequestSent(
+		not_null<Tdb::details::Instance*> instance,
+		Tdb::RequestId requestId,
+		uint32 type) {
+	TraceAsyncBegin(
+		"tdb",
+		"Tdb::Sender::request",
+		RequestTraceId(instance, requestId),
+		type);
+}
+
+void RequestFinished(
+		not_null<Tdb::details::Instance*> instance,
+		Tdb::RequestId requestId) {
+	TraceAsyncEnd(
+		"tdb",
+		"Tdb::Sender::request",
+		RequestTraceId(instance, requestId));
+}
+
+} // namespace
+
+void StartTracing() {
+	auto &collector = Instance();
+	QMutexLocker lock(&collector.mutex);
+	if (details::TracingEnabledValue.exchange(true)) {
+		return;
+	}
+	collector.events.reserve(kEventsReserve);
+	collector.startedThread = CurrentThread();
+	collector.dropped = 0;
+	lock.unlock();
+
+	Tdb::Sender::SetRequestHooks({
+		.sent = RequestSent,
+		.finished = RequestFinished,
+	});
+}
+
+void FinishTracing(const QString &path) {
+	auto &collector = Instance();
+	QMutexLocker lock(&collector.mutex);
+	if (!details::TracingEnabledValue.exchange(false)) {
+		return;
+	}
+	const auto events = base::take(collector.events);
+	const auto dropped = base::take(collector.dropped);
+	const auto startedThread = collector.startedThread;
+	lock.unlock();
+
+	Tdb::Sender::SetRequestHooks({});
+
+	QDir().mkpath(QFileInfo(path).absolutePath());
+	auto file = QFile(path);
+	if (!file.open(QIODevice::WriteOnly)) {
+		LOG(("Tracing Error: Could not open '%1' for writing.").arg(path));
+		return;
+	}
+	file.write(Serialize(events, startedThread));
+	LOG(("Tracing: Written %1 events to '%2', %3 dropped."
+		).arg(int(events.size())
+		).arg(path
+		).arg(dropped));
+}
+
+void TraceComplete(
+		const char *category,
+		const char *name,
+		crl::profile_time started,
+		crl::profile_time duration,
+		int64 value) {
+	if (!TracingEnabled()) {
+		return;
+	}
+	Record({
+		.category = category,
+		.name = name,
+		.timestamp = started,
+		.duration = duration,
+		.value = value,
+		.phase = 'X',
+	});
+}
+
+void TraceAsyncBegin(
+		const char *category,
+		const char *name,
+		uint64 id,
+		int64 value) {
+	if (!TracingEnabled()) {
+		return;
+	}
+	Record({
+		.category = category,
+		.name = name,
+		.timestamp = crl::profile(),
+		.id = id,
+		.value = value,
+		.phase = 'b',
+	});
+}
+
+void TraceAsyncEnd(const char *category, const char *name, uint64 id) {
+	if (!TracingEnabled()) {
+		return;
+	}
+	Record({
+		.category = category,
+		.name = name,
+		.timestamp = crl::profile(),
+		.id = id,
+		.phase = 'e',
+	});
+}
+
+} // namespace Core
@@ -0,0 +1,74 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+#include <atomic>
+
+namespace Core {
+namespace details {
+
+extern std::atomic<bool> TracingEnabledValue;
+
+} // namespace details
+
+// Collects spans in Chrome trace event format (chrome://tracing or
+// ui.perfetto.dev). Category and name must be string literals.
+[[nodiscard]] inline bool TracingEnabled() {
+	return details::TracingEnabledValue.load(std::memory_order_relaxed);
+}
+
+void StartTracing();
+void FinishTracing(const QString &path);
+
+void TraceComplete(
+	const char *category,
+	const char *name,
+	crl::profile_time started,
+	crl::profile_time duration,
+	int64 value = 0);
+void TraceAsyncBegin(
+	const char *category,
+	const char *name,
+	uint64 id,
+	int64 value = 0);
+void TraceAsyncEnd(const char *category, const char *name, uint64 id);
+
+class TraceSpan final {
+public:
+	TraceSpan(
+		const char *category,
+		const char *name,
+		int64 value = 0,
+		crl::profile_time threshold = 0)
+	: _category(category)
+	, _name(name)
+	, _value(value)
+	, _threshold(threshold)
+	, _started(TracingEnabled() ? crl::profile() : crl::profile_time()) {
+	}
+	TraceSpan(const TraceSpan &other) = delete;
+	TraceSpan &operator=(const TraceSpan &other) = delete;
+	~TraceSpan() {
+		if (_started) {
+			const auto duration = crl::profile() - _started;
+			if (duration >= _threshold) {
+				TraceComplete(_category, _name, _started, duration, _value);
+			}
+		}
+	}
+
+private:
+	const char *_category = nullptr;
+	const char *_name = nullptr;
+	int64 _value = 0;
+	crl::profile_time _threshold = 0;
+	crl::profile_time _started = 0;
+
+};
+
+} // namespace Core
@@ -13,6 +13,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "base/platform/base_platform_info.h"
 #include "base/platform/base_platform_file_utilities.h"
 #include "ui/main_queue_processor.h"
+#include "core/core_tracing.h"
 #include "core/crash_reports.h"
 #include "core/update_checker.h"
 #include "core/sandbox.h"
@@ -419,7 +420,10 @@ int Launcher::exec() {
 	}
 
 	// Must be started before Sandbox is created.
-	Platform::start();
+	{
+		const auto span = TraceSpan("startup", "Platform::start");
+		Platform::start();
+	}
 	auto result = executeApplication();
 
 	DEBUG_LOG(("Telegram finished, result: %1").arg(result));
@@ -436,6 +440,7 @@ int Launcher::exec() {
 
 	CrashReports::Finish();
 	Platform::finish();
+	FinishTracing(cWorkingDir() + u"DebugLogs/trace.json"_q);
 	Logs::finish();
 
 	return result;
@@ -541,6 +546,7 @@ void Launcher::processArguments() {
 	};
 	auto parseMap = std::map<QByteArray, KeyFormat> {
 		{ "-debug"          , KeyFormat::NoValues },
+		{ "-trace"          , KeyFormat::NoValues },
 		{ "-key"            , KeyFormat::OneValue },
 		{ "-autostart"      , KeyFormat::NoValues },
 		{ "-fixprevious"    , KeyFormat::NoValues },
@@ -578,6 +584,9 @@ void Launcher::processArguments() {
 	}
 
 	gDebugMode = parseResult.contains("-debug");
+	if (parseResult.contains("-trace")) {
+		StartTracing();
+	}
 	gKeyFile = parseResult.value("-key", {}).join(QString()).toLower();
 	gKeyFile = gKeyFile.replace(QRegularExpression("[^a-z0-9\\-_]"), {});
 	gLaunchMode = parseResult.contains("-autostart") ? LaunchModeAutoStart
@@ -23,7 +23,7 @@ void Changes::Manager<DataType, UpdateType>::updated(
 			flags |= i->second;
 			_updates.erase(i);
 		}
-		_stream.fire({ data, flags });
+		send({ data, flags });
 	} else {
 		_updates[data] |= flags;
 	}
@@ -41,6 +41,18 @@ void Changes::Manager<DataType, UpdateType>::sendRealtimeNotifications(
 	}
 }
 
+template <typename DataType, typename UpdateType>
+void Changes::Manager<DataType, UpdateType>::send(const UpdateType &update) {
+	_stream.fire_copy(update);
+	const auto [data, flags] = update;
+	const auto i = _buckets->find(data);
+	if (i != end(*_buckets)) {
+		// Subscribers may leave while the update is being delivered.
+		const auto bucket = i->second;
+		bucket->stream.fire_copy(update);
+	}
+}
+
 template <typename DataType, typename UpdateType>
 rpl::producer<UpdateType> Changes::Manager<DataType, UpdateType>::updates(
 		Flags flags) const {
@@ -54,11 +66,35 @@ template <typename DataType, typename UpdateType>
 rpl::producer<UpdateType> Changes::Manager<DataType, UpdateType>::updates(
 		not_null<DataType*> data,
 		Flags flags) const {
-	return _stream.events(
-	) | rpl::filter([=](const UpdateType &update) {
-		const auto [updateData, updateFlags] = update;
-		return (updateData == data) && (updateFlags & flags);
-	});
+	const auto weak = std::weak_ptr<Buckets>(_buckets);
+	return [=](auto consumer) {
+		const auto buckets = weak.lock();
+		if (!buckets) {
+			return rpl::lifetime();
+		}
+		auto &bucket = (*buckets)[data];
+		if (!bucket) {
+			bucket = std::make_shared<Bucket>();
+		}
+		++bucket->subscribers;
+		auto result = bucket->stream.events(
+		) | rpl::filter([=](const UpdateType &update) {
+			return (update.flags & flags);
+		}) | rpl::start_with_next([=](const UpdateType &update) {
+			consumer.put_next_copy(update);
+		});
+		result.add([=] {
+			const auto buckets = weak.lock();
+			if (!buckets) {
+				return;
+			}
+			const auto i = buckets->find(data);
+			if (i != end(*buckets) && !--i->second->subscribers) {
+				buckets->erase(i);
+			}
+		});
+		return result;
+	};
 }
 
 template <typename DataType, typename UpdateType>
@@ -84,7 +120,7 @@ void Changes::Manager<DataType, UpdateType>::drop(not_null<DataType*> data) {
 template <typename DataType, typename UpdateType>
 void Changes::Manager<DataType, UpdateType>::sendNotifications() {
 	for (const auto &[data, flags] : base::take(_updates)) {
-		_stream.fire({ data, flags });
+		send({ data, flags });
 	}
 }
 
@@ -367,13 +367,26 @@ private:
 	private:
 		static constexpr auto kCount = details::CountBit<Flag>() + 1;
 
+		// Subscribers to a single object are kept by the object,
+		// so that an update is delivered only to the interested ones.
+		struct Bucket {
+			rpl::event_stream<UpdateType> stream;
+			int subscribers = 0;
+		};
+		using Buckets = std::unordered_map<
+			not_null<DataType*>,
+			std::shared_ptr<Bucket>>;
+
 		void sendRealtimeNotifications(
 			not_null<DataType*> data,
 			Flags flags);
+		void send(const UpdateType &update);
 
 		std::array<rpl::event_stream<UpdateType>, kCount> _realtimeStreams;
 		base::flat_map<not_null<DataType*>, Flags> _updates;
 		rpl::event_stream<UpdateType> _stream;
+		const std::shared_ptr<Buckets> _buckets
+			= std::make_shared<Buckets>();
 
 	};
 
@@ -13,6 +13,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_cloud_themes.h"
 #include "data/data_file_origin.h"
 #include "data/data_auto_download.h"
+#include "data/data_image_decoder.h"
 #include "media/clip/media_clip_reader.h"
 #include "main/main_session.h"
 #include "main/main_session_settings.h"
@@ -206,6 +207,40 @@ Image *DocumentMedia::thumbnailInline() const {
 	return _inlineThumbnail.get();
 }
 
+Image *DocumentMedia::thumbnailInlineAsync() const {
+	// Requested only once, the pending request is not raised in the
+	// decoder queue on each paint until the image arrives.
+	if (!_inlineThumbnail
+		&& !_inlineThumbnailRequested
+		&& !_owner->inlineThumbnailIsPath()) {
+		const auto bytes = _owner->inlineThumbnailBytes();
+		if (!bytes.isEmpty()) {
+			_inlineThumbnailRequested = true;
+			const auto document = _owner;
+			auto done = [=](QImage image) {
+				if (image.isNull()) {
+					document->clearInlineThumbnailBytes();
+				} else if (const auto active = document->activeMediaView()) {
+					active->setInlineThumbnail(std::move(image));
+				}
+			};
+			_owner->owner().imageDecoder().request(
+				_owner,
+				bytes,
+				std::move(done));
+		}
+	}
+	return _inlineThumbnail.get();
+}
+
+void DocumentMedia::setInlineThumbnail(QImage image) {
+	if (_inlineThumbnail) {
+		return;
+	}
+	_inlineThumbnail = std::make_unique<Image>(std::move(image));
+	_owner->session().notifyDownloaderTaskFinished();
+}
+
 const QPainterPath &DocumentMedia::thumbnailPath() const {
 	if (_pathThumbnail.isEmpty()) {
 		if (_owner->inlineThumbnailIsPath()) {
@@ -56,6 +56,10 @@ public:
 	void setGoodThumbnail(QImage thumbnail);
 
 	[[nodiscard]] Image *thumbnailInline() const;
+
+	// Decodes in the background, returns nullptr until it is done.
+	[[nodiscard]] Image *thumbnailInlineAsync() const;
+	void setInlineThumbnail(QImage image);
 	[[nodiscard]] const QPainterPath &thumbnailPath() const;
 
 	[[nodiscard]] Image *thumbnail() const;
@@ -109,6 +113,7 @@ private:
 	const not_null<DocumentData*> _owner;
 	std::unique_ptr<Image> _goodThumbnail;
 	mutable std::unique_ptr<Image> _inlineThumbnail;
+	mutable bool _inlineThumbnailRequested = false;
 	mutable QPainterPath _pathThumbnail;
 	std::unique_ptr<Image> _thumbnail;
 	std::unique_ptr<Image> _sticker;
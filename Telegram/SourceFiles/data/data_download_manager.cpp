@@ -47,19 +47,7 @@ using namespace Tdb;
 constexpr auto kClearLoadingTimeout = 5 * crl::time(1000);
 constexpr auto kMaxFileSize = 4000 * int64(1024 * 1024);
 constexpr auto kMaxResolvePerAttempt = 100;
-
-constexpr auto ByItem = [](const auto &entry) {
-	if constexpr (std::is_same_v<decltype(entry), const DownloadingId&>) {
-		return entry.object.item;
-	} else {
-		const auto resolved = entry.object.get();
-		return resolved ? resolved->item.get() : nullptr;
-	}
-};
-
-constexpr auto ByDocument = [](const auto &entry) {
-	return entry.object.document;
-};
+constexpr auto kMaxDownloadedCount = 99'999;
 
 template <typename Type>
 [[nodiscard]] uint64 IdFrom(Type *item) {
@@ -120,6 +108,61 @@ struct DocumentDescriptor {
 	FullMsgId itemId;
 };
 
+void SerializeEntry(QDataStream &stream, const DownloadedId &id) {
+	stream
+		<< quint64(id.download.objectId)
+		<< qint32(id.download.type)
+		<< qint64(id.started)
+		// FileSize: Right now any file size fits 32 bit.
+		<< quint32(id.size)
+		<< quint64(id.itemId.peer.value)
+		<< qint64(id.itemId.msg.bare)
+		<< quint64(id.peerAccessHash)
+		<< id.path;
+}
+
+[[nodiscard]] std::unique_ptr<DownloadedId> DeserializeEntry(
+		QDataStream &stream) {
+	auto downloadObjectId = quint64();
+	auto uncheckedDownloadType = qint32();
+	auto started = qint64();
+	// FileSize: Right now any file size fits 32 bit.
+	auto size = quint32();
+	auto itemIdPeer = quint64();
+	auto itemIdMsg = qint64();
+	auto peerAccessHash = quint64();
+	auto path = QString();
+	stream
+		>> downloadObjectId
+		>> uncheckedDownloadType
+		>> started
+		>> size
+		>> itemIdPeer
+		>> itemIdMsg
+		>> peerAccessHash
+		>> path;
+	const auto downloadType = DownloadType(uncheckedDownloadType);
+	if (stream.status() != QDataStream::Ok
+		|| path.isEmpty()
+		|| size <= 0
+		|| size > kMaxFileSize
+		|| (downloadType != DownloadType::Document
+			&& downloadType != DownloadType::Photo)) {
+		return nullptr;
+	}
+	return std::make_unique<DownloadedId>(DownloadedId{
+		.download = {
+			.objectId = downloadObjectId,
+			.type = downloadType,
+		},
+		.started = started,
+		.path = path,
+		.size = int64(size),
+		.itemId = { PeerId(itemIdPeer), MsgId(itemIdMsg) },
+		.peerAccessHash = peerAccessHash,
+	});
+}
+
 } // namespace
 
 struct DownloadManager::DeleteFilesDescriptor {
@@ -127,6 +170,13 @@ struct DownloadManager::DeleteFilesDescriptor {
 	base::flat_map<QString, DocumentDescriptor> files;
 };
 
+struct DownloadManager::ResolveCheck {
+	not_null<DownloadedId*> id;
+	QString path;
+	int64 size = 0;
+	bool exists = false;
+};
+
 DownloadManager::DownloadManager()
 : _clearLoadingTimer([=] { clearLoading(); }) {
 }
@@ -209,7 +259,7 @@ void DownloadManager::addLoading(DownloadObject object) {
 	const auto item = object.item;
 	auto &data = sessionData(item);
 
-	const auto already = ranges::find(data.downloading, item, ByItem);
+	const auto already = findDownloading(data, item);
 	if (already != end(data.downloading)) {
 		const auto document = already->object.document;
 		const auto photo = already->object.photo;
@@ -236,6 +286,7 @@ void DownloadManager::addLoading(DownloadObject object) {
 		.hiddenByView = (!shownExists
 			&& item->history()->owner().queryItemVisibility(item)),
 	});
+	indexDownloading(data, data.downloading.size() - 1);
 	_loading.emplace(item);
 	_loadingDocuments.emplace(object.document);
 	_loadingProgress = DownloadProgress{
@@ -250,17 +301,14 @@ void DownloadManager::addLoading(DownloadObject object) {
 
 void DownloadManager::check(not_null<const HistoryItem*> item) {
 	auto &data = sessionData(item);
-	const auto i = ranges::find(data.downloading, item, ByItem);
+	const auto i = findDownloading(data, item);
 	Assert(i != end(data.downloading));
 	check(data, i);
 }
 
 void DownloadManager::check(not_null<DocumentData*> document) {
 	auto &data = sessionData(document);
-	const auto i = ranges::find(
-		data.downloading,
-		document.get(),
-		ByDocument);
+	const auto i = findDownloading(data, document);
 	Assert(i != end(data.downloading));
 	check(data, i);
 }
@@ -323,7 +371,14 @@ void DownloadManager::addLoaded(
 #endif
 		? DownloadId{ IdFrom(object.document), DownloadType::Document }
 		: DownloadId{ IdFrom(object.photo), DownloadType::Photo };
-	data.downloaded.push_back({
+	const auto session = &item->history()->session();
+	if (const auto already = findDownloaded(data, item)) {
+		data.downloaded.erase(ranges::find_if(data.downloaded, [&](
+				const std::unique_ptr<DownloadedId> &id) {
+			return (id.get() == already);
+		}));
+	}
+	data.downloaded.push_back(std::make_unique<DownloadedId>(DownloadedId{
 		.download = id,
 		.started = started,
 		.path = path,
@@ -331,13 +386,15 @@ void DownloadManager::addLoaded(
 		.itemId = item->fullId(),
 		.peerAccessHash = PeerAccessHash(item->history()->peer),
 		.object = std::make_unique<DownloadObject>(object),
-	});
+	}));
+	const auto added = data.downloaded.back().get();
+	indexDownloaded(data, added);
 	_loaded.emplace(item);
-	_loadedAdded.fire(&data.downloaded.back());
+	_loadedAdded.fire(added);
 
-	writePostponed(&item->history()->session());
+	writePostponed(session);
 
-	const auto i = ranges::find(data.downloading, item, ByItem);
+	const auto i = findDownloading(data, item);
 	if (i != end(data.downloading)) {
 		auto &entry = *i;
 		const auto document = entry.object.document;
@@ -375,6 +432,7 @@ void DownloadManager::clearIfFinished() {
 
 void DownloadManager::deleteFiles(const std::vector<GlobalMsgId> &ids) {
 	auto descriptor = DeleteFilesDescriptor();
+	auto removed = base::flat_set<not_null<DownloadedId*>>();
 	for (const auto &id : ids) {
 		if (const auto item = MessageByGlobalId(id)) {
 			const auto session = &item->history()->session();
@@ -383,16 +441,12 @@ void DownloadManager::deleteFiles(const std::vector<GlobalMsgId> &ids) {
 				continue;
 			}
 			auto &data = i->second;
-			const auto j = ranges::find(
-				data.downloading,
-				not_null{ item },
-				ByItem);
+			const auto j = findDownloading(data, item);
 			if (j != end(data.downloading)) {
 				cancel(data, j);
 			}
 
-			const auto k = ranges::find(data.downloaded, item, ByItem);
-			if (k != end(data.downloaded)) {
+			if (const auto k = findDownloaded(data, item)) {
 				const auto document = k->object->document;
 				descriptor.files.emplace(k->path, DocumentDescriptor{
 					.sessionUniqueId = id.sessionUniqueId,
@@ -404,13 +458,21 @@ void DownloadManager::deleteFiles(const std::vector<GlobalMsgId> &ids) {
 				if (document) {
 					_generatedDocuments.remove(document);
 				}
-				data.downloaded.erase(k);
+				data.downloadedByItem.erase(item);
+				removed.emplace(k);
 				_loadedRemoved.fire_copy(item);
 
 				descriptor.sessions.emplace(session);
 			}
 		}
 	}
+	for (const auto &session : descriptor.sessions) {
+		auto &list = sessionData(session).downloaded;
+		list.erase(ranges::remove_if(list, [&](
+				const std::unique_ptr<DownloadedId> &id) {
+			return removed.contains(id.get());
+		}), end(list));
+	}
 	finishFilesDelete(std::move(descriptor));
 }
 
@@ -426,13 +488,19 @@ void DownloadManager::deleteAll() {
 		while (!data.downloading.empty()) {
 			cancel(data, data.downloading.end() - 1);
 		}
-		for (auto &id : base::take(data.downloaded)) {
-			const auto object = id.object.get();
+		data.downloadedByItem.clear();
+		data.resolveNeeded
+			= data.resolveSentTotal
+			= data.resolveSentRequests
+			= 0;
+		++data.resolveGeneration;
+		for (const auto &id : base::take(data.downloaded)) {
+			const auto object = id->object.get();
 			const auto document = object ? object->document : nullptr;
-			descriptor.files.emplace(id.path, DocumentDescriptor{
+			descriptor.files.emplace(id->path, DocumentDescriptor{
 				.sessionUniqueId = sessionUniqueId,
 				.documentId = document ? document->id : DocumentId(),
-				.itemId = id.itemId,
+				.itemId = id->itemId,
 			});
 			if (document) {
 				_generatedDocuments.remove(document);
@@ -451,9 +519,6 @@ void DownloadManager::deleteAll() {
 }
 
 void DownloadManager::finishFilesDelete(DeleteFilesDescriptor &&descriptor) {
-	for (const auto &session : descriptor.sessions) {
-		writePostponed(session);
-	}
 	crl::async([files = std::move(descriptor.files)]{
 		for (const auto &file : files) {
 			QFile(file.first).remove();
@@ -477,7 +542,7 @@ void DownloadManager::finishFilesDelete(DeleteFilesDescriptor &&descriptor) {
 bool DownloadManager::loadedHasNonCloudFile() const {
 	for (const auto &[session, data] : _sessions) {
 		for (const auto &id : data.downloaded) {
-			if (const auto object = id.object.get()) {
+			if (const auto object = id->object.get()) {
 				if (!object->item->isHistoryEntry()) {
 					return true;
 				}
@@ -624,10 +689,13 @@ auto DownloadManager::loadedList()
 	) | ranges::views::transform([=](const auto &pair) {
 		return ranges::views::all(
 			pair.second.downloaded
-		) | ranges::views::filter([](const DownloadedId &id) {
-			return (id.object != nullptr);
-		}) | ranges::views::transform([](const DownloadedId &id) {
-			return &id;
+		) | ranges::views::filter([](
+				const std::unique_ptr<DownloadedId> &id) {
+			return (id->object != nullptr);
+		}) | ranges::views::transform([](
+				const std::unique_ptr<DownloadedId> &id)
+				-> const DownloadedId* {
+			return id.get();
 		});
 	}) | ranges::views::join;
 }
@@ -647,6 +715,41 @@ void DownloadManager::resolve(
 		|| data.resolveSentTotal >= kMaxResolvePerAttempt) {
 		return;
 	}
+	auto checks = std::vector<ResolveCheck>();
+	auto last = begin(data.downloaded);
+	auto from = last + (data.resolveNeeded - data.resolveSentTotal);
+	for (auto i = from; i != last;) {
+		const auto id = (--i)->get();
+		checks.push_back({ .id = id, .path = id->path, .size = id->size });
+		if (++data.resolveSentTotal >= kMaxResolvePerAttempt) {
+			break;
+		}
+	}
+
+	// Checking files on disk may be slow, so do it in the background.
+	++data.resolveSentRequests;
+	const auto generation = data.resolveGeneration;
+	const auto weak = base::make_weak(session);
+	crl::async([=, checks = std::move(checks)]() mutable {
+		for (auto &check : checks) {
+			const auto info = QFileInfo(check.path);
+			check.exists = info.exists() && (info.size() == check.size);
+		}
+		crl::on_main(weak, [=, checks = std::move(checks)]() mutable {
+			resolveChecked(session, generation, std::move(checks));
+		});
+	});
+}
+
+void DownloadManager::resolveChecked(
+		not_null<Main::Session*> session,
+		int generation,
+		std::vector<ResolveCheck> checks) {
+	const auto i = _sessions.find(session);
+	if (i == end(_sessions) || i->second.resolveGeneration != generation) {
+		return;
+	}
+	auto &data = i->second;
 #if 0 // mtp
 	struct Prepared {
 		uint64 peerAccessHash = 0;
@@ -658,13 +761,10 @@ void DownloadManager::resolve(
 	auto prepared = base::flat_map<PeerId, Prepared>();
 #endif
 	auto prepared = base::flat_set<FullMsgId>();
-	auto last = begin(data.downloaded);
-	auto from = last + (data.resolveNeeded - data.resolveSentTotal);
-	for (auto i = from; i != last;) {
-		auto &id = *--i;
+	for (const auto &check : checks) {
+		auto &id = *check.id;
 		const auto msgId = id.itemId.msg;
-		const auto info = QFileInfo(id.path);
-		if (!info.exists() || info.size() != id.size) {
+		if (!check.exists) {
 			// Mark as deleted.
 			id.path = QString();
 		} else if (!owner.message(id.itemId) && IsServerMsgId(msgId)) {
@@ -680,9 +780,6 @@ void DownloadManager::resolve(
 #endif
 			prepared.emplace(id.itemId);
 		}
-		if (++data.resolveSentTotal >= kMaxResolvePerAttempt) {
-			break;
-		}
 	}
 	const auto check = [=] {
 		auto &data = sessionData(session);
@@ -691,8 +788,11 @@ void DownloadManager::resolve(
 		}
 	};
 	const auto requestFinished = [=] {
-		--sessionData(session).resolveSentRequests;
-		check();
+		auto &data = sessionData(session);
+		if (data.resolveGeneration == generation) {
+			--data.resolveSentRequests;
+			check();
+		}
 	};
 	for (const auto &itemId : prepared) {
 		session->sender().request(TLgetMessage(
@@ -727,7 +827,8 @@ void DownloadManager::resolve(
 		}
 	}
 #endif
-	data.resolveSentRequests += prepared.size();
+	// One request was counted for the background files check.
+	data.resolveSentRequests += int(prepared.size()) - 1;
 	check();
 }
 
@@ -737,38 +838,42 @@ void DownloadManager::resolveRequestsFinished(
 	auto &owner = session->data();
 	for (; data.resolveSentTotal > 0; --data.resolveSentTotal) {
 		const auto i = begin(data.downloaded) + (--data.resolveNeeded);
-		if (i->path.isEmpty()) {
+		auto &id = **i;
+		if (id.path.isEmpty()) {
 			data.downloaded.erase(i);
 			continue;
 		}
-		const auto item = owner.message(i->itemId);
+		const auto item = owner.message(id.itemId);
 		const auto media = item ? item->media() : nullptr;
 		const auto document = media ? media->document() : nullptr;
 		const auto photo = media ? media->photo() : nullptr;
-		if (i->download.type == DownloadType::Document
+		if (id.download.type == DownloadType::Document
 #if 0 // mtp
-			&& (!document || document->id != i->download.objectId)) {
+			&& (!document || document->id != id.download.objectId)) {
 #endif
-			&& (!document || IdFrom(document) != i->download.objectId)) {
-			generateEntry(session, *i);
-		} else if (i->download.type == DownloadType::Photo
+			&& (!document || IdFrom(document) != id.download.objectId)) {
+			generateEntry(session, data, id);
+		} else if (id.download.type == DownloadType::Photo
 #if 0 // mtp
-			&& (!photo || photo->id != i->download.objectId)) {
+			&& (!photo || photo->id != id.download.objectId)) {
 #endif
-			&& (!photo || IdFrom(photo) != i->download.objectId)) {
-			generateEntry(session, *i);
+			&& (!photo || IdFrom(photo) != id.download.objectId)) {
+			generateEntry(session, data, id);
 		} else {
-			i->object = std::make_unique<DownloadObject>(DownloadObject{
+			id.object = std::make_unique<DownloadObject>(DownloadObject{
 				.item = item,
 				.document = document,
 				.photo = photo,
 			});
+			indexDownloaded(data, &id);
 			_loaded.emplace(item);
 		}
-		_loadedAdded.fire(&*i);
+		_loadedAdded.fire(&id);
 	}
 	crl::on_main(session, [=] {
-		resolve(session, sessionData(session));
+		if (const auto i = _sessions.find(session); i != end(_sessions)) {
+			resolve(session, i->second);
+		}
 	});
 }
 
@@ -787,18 +892,19 @@ void DownloadManager::checkFullResolveDone() {
 
 void DownloadManager::generateEntry(
 		not_null<Main::Session*> session,
+		SessionData &data,
 		DownloadedId &id) {
 	Expects(!id.object);
 
 	const auto info = QFileInfo(id.path);
-	const auto data = Data::DocumentLocalData{
+	const auto local = Data::DocumentLocalData{
 		.id = base::RandomValue<DocumentId>(),
 		.added = TimeId(id.started / 1000),
 		.name = info.fileName(),
 		.mime = Core::MimeTypeForFile(info).name(),
 		.size = id.size,
 	};
-	const auto document = session->data().processDocument(data);
+	const auto document = session->data().processDocument(local);
 #if 0 // mtp
 	const auto document = session->data().document(
 		base::RandomValue<DocumentId>(),
@@ -824,6 +930,7 @@ void DownloadManager::generateEntry(
 		.item = generateFakeItem(document),
 		.document = document,
 	});
+	indexDownloaded(data, &id);
 	_loaded.emplace(id.object->item);
 }
 
@@ -844,12 +951,16 @@ void DownloadManager::remove(
 		.ready = _loadingProgress.current().ready - i->ready,
 		.total = _loadingProgress.current().total - i->total,
 	};
+	const auto position = int(i - begin(data.downloading));
 	_loading.remove(i->object.item);
 	_loadingDone.remove(i->object.item);
+	data.downloadingByItem.erase(i->object.item);
 	if (const auto document = i->object.document) {
 		_loadingDocuments.remove(document);
+		data.downloadingByDocument.erase(document);
 	}
 	data.downloading.erase(i);
+	indexDownloading(data, position);
 	_loadingListChanges.fire({});
 	_loadingProgress = now;
 	if (_loading.empty() && !_loadingDone.empty()) {
@@ -875,14 +986,14 @@ void DownloadManager::cancel(
 void DownloadManager::changed(not_null<const HistoryItem*> item) {
 	if (_loaded.contains(item)) {
 		auto &data = sessionData(item);
-		const auto i = ranges::find(data.downloaded, item.get(), ByItem);
-		Assert(i != end(data.downloaded));
+		const auto id = findDownloaded(data, item);
+		Assert(id != nullptr);
 
 		const auto media = item->media();
 		const auto photo = media ? media->photo() : nullptr;
 		const auto document = media ? media->document() : nullptr;
-		if (i->object->photo != photo || i->object->document != document) {
-			detach(*i);
+		if (id->object->photo != photo || id->object->document != document) {
+			detach(data, *id);
 		}
 	}
 	if (_loading.contains(item) || _loadingDone.contains(item)) {
@@ -893,13 +1004,13 @@ void DownloadManager::changed(not_null<const HistoryItem*> item) {
 void DownloadManager::removed(not_null<const HistoryItem*> item) {
 	if (_loaded.contains(item)) {
 		auto &data = sessionData(item);
-		const auto i = ranges::find(data.downloaded, item.get(), ByItem);
-		Assert(i != end(data.downloaded));
-		detach(*i);
+		const auto id = findDownloaded(data, item);
+		Assert(id != nullptr);
+		detach(data, *id);
 	}
 	if (_loading.contains(item) || _loadingDone.contains(item)) {
 		auto &data = sessionData(item);
-		const auto i = ranges::find(data.downloading, item, ByItem);
+		const auto i = findDownloading(data, item);
 		Assert(i != end(data.downloading));
 
 		// We don't want to download files without messages.
@@ -958,7 +1069,7 @@ not_null<HistoryItem*> DownloadManager::generateItem(
 	return result;
 }
 
-void DownloadManager::detach(DownloadedId &id) {
+void DownloadManager::detach(SessionData &data, DownloadedId &id) {
 	Expects(id.object != nullptr);
 	Expects(_loaded.contains(id.object->item));
 	Expects(!_generated.contains(id.object->item));
@@ -968,7 +1079,9 @@ void DownloadManager::detach(DownloadedId &id) {
 	const auto now = regenerateItem(*id.object);
 	_loaded.remove(was);
 	_loaded.emplace(now);
+	data.downloadedByItem.erase(was);
 	id.object->item = now;
+	indexDownloaded(data, &id);
 
 	_loadedRemoved.fire_copy(was);
 	_loadedAdded.fire_copy(&id);
@@ -1025,7 +1138,7 @@ Fn<std::optional<QByteArray>()> DownloadManager::serializator(
 		auto size = sizeof(qint32) // count
 			+ count * constant;
 		for (const auto &id : data.downloaded) {
-			size += Serialize::stringSize(id.path);
+			size += Serialize::stringSize(id->path);
 		}
 		result.reserve(size);
 
@@ -1033,16 +1146,7 @@ Fn<std::optional<QByteArray>()> DownloadManager::serializator(
 		stream.setVersion(QDataStream::Qt_5_1);
 		stream << qint32(count);
 		for (const auto &id : data.downloaded) {
-			stream
-				<< quint64(id.download.objectId)
-				<< qint32(id.download.type)
-				<< qint64(id.started)
-				// FileSize: Right now any file size fits 32 bit.
-				<< quint32(id.size)
-				<< quint64(id.itemId.peer.value)
-				<< qint64(id.itemId.msg.bare)
-				<< quint64(id.peerAccessHash)
-				<< id.path;
+			SerializeEntry(stream, *id);
 		}
 		stream.device()->close();
 
@@ -1050,8 +1154,8 @@ Fn<std::optional<QByteArray>()> DownloadManager::serializator(
 	};
 }
 
-std::vector<DownloadedId> DownloadManager::deserialize(
-		not_null<Main::Session*> session) const {
+auto DownloadManager::deserialize(not_null<Main::Session*> session) const
+-> std::vector<std::unique_ptr<DownloadedId>> {
 	const auto serialized = session->account().local().downloadsSerialized();
 	if (serialized.isEmpty()) {
 		return {};
@@ -1062,60 +1166,75 @@ std::vector<DownloadedId> DownloadManager::deserialize(
 
 	auto count = qint32();
 	stream >> count;
-	if (stream.status() != QDataStream::Ok || count <= 0 || count > 99'999) {
+	if (stream.status() != QDataStream::Ok
+		|| count <= 0
+		|| count > kMaxDownloadedCount) {
 		return {};
 	}
-	auto result = std::vector<DownloadedId>();
+	auto result = std::vector<std::unique_ptr<DownloadedId>>();
 	result.reserve(count);
 	for (auto i = 0; i != count; ++i) {
-		auto downloadObjectId = quint64();
-		auto uncheckedDownloadType = qint32();
-		auto started = qint64();
-		// FileSize: Right now any file size fits 32 bit.
-		auto size = quint32();
-		auto itemIdPeer = quint64();
-		auto itemIdMsg = qint64();
-		auto peerAccessHash = quint64();
-		auto path = QString();
-		stream
-			>> downloadObjectId
-			>> uncheckedDownloadType
-			>> started
-			>> size
-			>> itemIdPeer
-			>> itemIdMsg
-			>> peerAccessHash
-			>> path;
-		const auto downloadType = DownloadType(uncheckedDownloadType);
-		if (stream.status() != QDataStream::Ok
-			|| path.isEmpty()
-			|| size <= 0
-			|| size > kMaxFileSize
-			|| (downloadType != DownloadType::Document
-				&& downloadType != DownloadType::Photo)) {
+		auto entry = DeserializeEntry(stream);
+		if (!entry) {
 			return {};
 		}
-		result.push_back({
-			.download = {
-				.objectId = downloadObjectId,
-				.type = downloadType,
-			},
-			.started = started,
-			.path = path,
-			.size = int64(size),
-			.itemId = { PeerId(itemIdPeer), MsgId(itemIdMsg) },
-			.peerAccessHash = peerAccessHash,
-		});
+		result.push_back(std::move(entry));
 	}
 	return result;
 }
 
+void DownloadManager::indexDownloading(SessionData &data, int from) {
+	const auto count = int(data.downloading.size());
+	for (auto i = from; i < count; ++i) {
+		const auto &object = data.downloading[i].object;
+		data.downloadingByItem[object.item] = i;
+		if (const auto document = object.document) {
+			data.downloadingByDocument[document] = i;
+		}
+	}
+}
+
+void DownloadManager::indexDownloaded(
+		SessionData &data,
+		not_null<DownloadedId*> id) {
+	Expects(id->object != nullptr);
+
+	data.downloadedByItem[id->object->item] = id;
+}
+
+auto DownloadManager::findDownloading(
+	SessionData &data,
+	not_null<const HistoryItem*> item)
+-> std::vector<DownloadingId>::iterator {
+	const auto i = data.downloadingByItem.find(item);
+	return (i != end(data.downloadingByItem))
+		? (begin(data.downloading) + i->second)
+		: end(data.downloading);
+}
+
+auto DownloadManager::findDownloading(
+	SessionData &data,
+	not_null<DocumentData*> document)
+-> std::vector<DownloadingId>::iterator {
+	const auto i = data.downloadingByDocument.find(document);
+	return (i != end(data.downloadingByDocument))
+		? (begin(data.downloading) + i->second)
+		: end(data.downloading);
+}
+
+DownloadedId *DownloadManager::findDownloaded(
+		SessionData &data,
+		not_null<const HistoryItem*> item) {
+	const auto i = data.downloadedByItem.find(item);
+	return (i != end(data.downloadedByItem)) ? i->second.get() : nullptr;
+}
+
 void DownloadManager::untrack(not_null<Main::Session*> session) {
 	const auto i = _sessions.find(session);
 	Assert(i != end(_sessions));
 
 	for (const auto &entry : i->second.downloaded) {
-		if (const auto resolved = entry.object.get()) {
+		if (const auto resolved = entry->object.get()) {
 			const auto item = resolved->item;
 			_loaded.remove(item);
 			_generated.remove(item);
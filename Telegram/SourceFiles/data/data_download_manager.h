@@ -119,12 +119,19 @@ public:
 
 private:
 	struct DeleteFilesDescriptor;
+	struct ResolveCheck;
 	struct SessionData {
-		std::vector<DownloadedId> downloaded;
+		std::vector<std::unique_ptr<DownloadedId>> downloaded;
+		std::unordered_map<
+			not_null<const HistoryItem*>,
+			not_null<DownloadedId*>> downloadedByItem;
 		std::vector<DownloadingId> downloading;
+		std::unordered_map<not_null<const HistoryItem*>, int> downloadingByItem;
+		std::unordered_map<not_null<DocumentData*>, int> downloadingByDocument;
 		int resolveNeeded = 0;
 		int resolveSentRequests = 0;
 		int resolveSentTotal = 0;
+		int resolveGeneration = 0;
 		rpl::lifetime lifetime;
 	};
 
@@ -135,8 +142,19 @@ private:
 		std::vector<DownloadingId>::iterator i);
 	void changed(not_null<const HistoryItem*> item);
 	void removed(not_null<const HistoryItem*> item);
-	void detach(DownloadedId &id);
+	void detach(SessionData &data, DownloadedId &id);
 	void untrack(not_null<Main::Session*> session);
+	void indexDownloading(SessionData &data, int from);
+	void indexDownloaded(SessionData &data, not_null<DownloadedId*> id);
+	[[nodiscard]] std::vector<DownloadingId>::iterator findDownloading(
+		SessionData &data,
+		not_null<const HistoryItem*> item);
+	[[nodiscard]] std::vector<DownloadingId>::iterator findDownloading(
+		SessionData &data,
+		not_null<DocumentData*> document);
+	[[nodiscard]] DownloadedId *findDownloaded(
+		SessionData &data,
+		not_null<const HistoryItem*> item);
 	void remove(
 		SessionData &data,
 		std::vector<DownloadingId>::iterator i);
@@ -153,6 +171,10 @@ private:
 	[[nodiscard]] SessionData &sessionData(not_null<DocumentData*> document);
 
 	void resolve(not_null<Main::Session*> session, SessionData &data);
+	void resolveChecked(
+		not_null<Main::Session*> session,
+		int generation,
+		std::vector<ResolveCheck> checks);
 	void resolveRequestsFinished(
 		not_null<Main::Session*> session,
 		SessionData &data);
@@ -166,7 +188,10 @@ private:
 		HistoryItem *previousItem,
 		DocumentData *document,
 		PhotoData *photo);
-	void generateEntry(not_null<Main::Session*> session, DownloadedId &id);
+	void generateEntry(
+		not_null<Main::Session*> session,
+		SessionData &data,
+		DownloadedId &id);
 
 	[[nodiscard]] HistoryItem *lookupLoadingItem(
 		Main::Session *onlyInSession) const;
@@ -176,8 +201,8 @@ private:
 	void writePostponed(not_null<Main::Session*> session);
 	[[nodiscard]] Fn<std::optional<QByteArray>()> serializator(
 		not_null<Main::Session*> session) const;
-	[[nodiscard]] std::vector<DownloadedId> deserialize(
-		not_null<Main::Session*> session) const;
+	[[nodiscard]] auto deserialize(not_null<Main::Session*> session) const
+		-> std::vector<std::unique_ptr<DownloadedId>>;
 
 	base::flat_map<not_null<Main::Session*>, SessionData> _sessions;
 	base::flat_set<not_null<const HistoryItem*>> _loading;
@@ -16,6 +16,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_forum_topic.h"
 #include "data/data_scheduled_messages.h"
 #include "data/data_user.h"
+#include "base/options.h"
 #include "base/unixtime.h"
 #include "base/random.h"
 #include "main/main_session.h"
@@ -36,11 +37,31 @@ namespace Data {
 namespace {
 
 constexpr auto kReadRequestTimeout = 3 * crl::time(1000);
+constexpr auto kResidentCheckDelay = 5 * crl::time(1000);
+constexpr auto kDefaultResidentBudget = int64(96) * 1024 * 1024;
+constexpr auto kReducedResidentBudget = int64(32) * 1024 * 1024;
+
+// Rough average size of a message view with its text layout and media.
+constexpr auto kEstimatedViewSize = int64(4) * 1024;
+
+// Rough average size of the text and components of an item,
+// in addition to the item object itself.
+constexpr auto kEstimatedItemDataSize = int64(1) * 1024;
 
 using namespace Tdb;
 
+base::options::toggle OptionKeepFewerChatsLoaded({
+	.id = kOptionKeepFewerChatsLoaded,
+	.name = "Keep fewer chats loaded",
+	.description = "Unload messages of chats that were not viewed "
+		"recently sooner, to use less memory.",
+	.restartRequired = true,
+});
+
 } // namespace
 
+const char kOptionKeepFewerChatsLoaded[] = "keep-fewer-chats-loaded";
+
 #if 0 // mtp
 MTPInputReplyTo ReplyToForMTP(
 		not_null<History*> history,
@@ -109,7 +130,11 @@ MTPInputMedia WebPageForMTP(
 
 Histories::Histories(not_null<Session*> owner)
 : _owner(owner)
-, _readRequestsTimer([=] { sendReadRequests(); }) {
+, _readRequestsTimer([=] { sendReadRequests(); })
+, _residentTimer([=] { checkResidentBudget(); }) {
+	setResidentBudget(OptionKeepFewerChatsLoaded.value()
+		? kReducedResidentBudget
+		: kDefaultResidentBudget);
 }
 
 Session &Histories::owner() const {
@@ -141,10 +166,140 @@ void Histories::unloadAll() {
 	for (const auto &[peerId, history] : _map) {
 		history->clear(History::ClearType::Unload);
 	}
+	releaseEmptySlabs();
+}
+
+not_null<HistoryArena*> Histories::itemsArena() {
+	return &_itemsArena;
+}
+
+not_null<HistoryArena*> Histories::viewsArena() {
+	return &_viewsArena;
+}
+
+HistoryArena::Stats Histories::arenaStats() const {
+	const auto items = _itemsArena.stats();
+	const auto views = _viewsArena.stats();
+	return {
+		.allocations = items.allocations + views.allocations,
+		.objects = items.objects + views.objects,
+		.slabs = items.slabs + views.slabs,
+		.usedBytes = items.usedBytes + views.usedBytes,
+		.reservedBytes = items.reservedBytes + views.reservedBytes,
+	};
+}
+
+void Histories::releaseEmptySlabs() {
+	_itemsArena.releaseEmpty();
+	_viewsArena.releaseEmpty();
 }
 
 void Histories::clearAll() {
+	_opened.clear();
+	_lastViewed.clear();
+	_residentTimer.cancel();
 	_map.clear();
+	releaseEmptySlabs();
+}
+
+void Histories::historyOpened(not_null<History*> history) {
+	++_opened[history];
+	_lastViewed[history] = crl::now();
+	_residentTimer.callOnce(kResidentCheckDelay);
+}
+
+void Histories::historyClosed(not_null<History*> history) {
+	const auto i = _opened.find(history);
+	if (i == end(_opened)) {
+		return;
+	} else if (!--i->second) {
+		_opened.erase(i);
+	}
+	_lastViewed[history] = crl::now();
+	_residentTimer.callOnce(kResidentCheckDelay);
+}
+
+void Histories::residentViewAdded(not_null<History*> history) {
+	++_residentViews[history];
+	++_residentViewsTotal;
+}
+
+void Histories::residentViewRemoved(not_null<History*> history) {
+	const auto i = _residentViews.find(history);
+	if (i == end(_residentViews)) {
+		return;
+	} else if (!--i->second) {
+		_residentViews.erase(i);
+	}
+	--_residentViewsTotal;
+}
+
+void Histories::setResidentBudget(int64 viewsSize) {
+	_residentBudget = viewsSize;
+	_residentTimer.callOnce(kResidentCheckDelay);
+}
+
+auto Histories::residentStats() const -> ResidentStats {
+	const auto items = _itemsArena.stats();
+	return {
+		.viewsSize = _residentViewsTotal * kEstimatedViewSize,
+		.itemsSize = items.usedBytes + items.objects * kEstimatedItemDataSize,
+		.budget = _residentBudget,
+		.histories = int(_residentViews.size()),
+		.evictions = _residentEvictions,
+	};
+}
+
+bool Histories::canUnloadResident(not_null<History*> history) {
+	const auto opened = [&](not_null<History*> history) {
+		return _opened.contains(history);
+	};
+	if (opened(history) || opened(history->migrateToOrMe())) {
+		return false;
+	} else if (history->isPinnedDialog(FilterId())) {
+		return false;
+	} else if (const auto state = lookup(history)) {
+		// Don't drop the blocks while a slice of them is being loaded.
+		return state->sent.empty();
+	}
+	return true;
+}
+
+void Histories::checkResidentBudget() {
+	const auto over = [&] {
+		return _residentViewsTotal * kEstimatedViewSize > _residentBudget;
+	};
+	if (!over()) {
+		return;
+	}
+	struct Resident {
+		not_null<History*> history;
+		crl::time lastViewed = 0;
+	};
+	auto resident = std::vector<Resident>();
+	resident.reserve(_residentViews.size());
+	for (const auto &[history, views] : _residentViews) {
+		const auto i = _lastViewed.find(history);
+		resident.push_back({
+			.history = history,
+			.lastViewed = (i != end(_lastViewed)) ? i->second : 0,
+		});
+	}
+	ranges::sort(resident, ranges::less(), &Resident::lastViewed);
+	for (const auto &entry : resident) {
+		if (!over()) {
+			break;
+		} else if (!canUnloadResident(entry.history)) {
+			continue;
+		}
+		entry.history->clear(History::ClearType::Unload);
+		_lastViewed.remove(entry.history);
+		++_residentEvictions;
+		DEBUG_LOG(("Histories: Unloaded %1, %2 views resident."
+			).arg(entry.history->peer->id.value
+			).arg(_residentViewsTotal));
+	}
+	releaseEmptySlabs();
 }
 
 void Histories::readInbox(not_null<History*> history) {
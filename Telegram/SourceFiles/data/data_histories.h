@@ -8,6 +8,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #pragma once
 
 #include "base/timer.h"
+#include "history/history_arena.h"
 
 class History;
 class HistoryItem;
@@ -27,6 +28,8 @@ class Session;
 class Folder;
 struct WebPageDraft;
 
+extern const char kOptionKeepFewerChatsLoaded[];
+
 #if 0 // mtp
 [[nodiscard]] MTPInputReplyTo ReplyToForMTP(
 	not_null<History*> history,
@@ -61,6 +64,34 @@ public:
 	void unloadAll();
 	void clearAll();
 
+	[[nodiscard]] not_null<HistoryArena*> itemsArena();
+	[[nodiscard]] not_null<HistoryArena*> viewsArena();
+
+	// Items and views of all histories together.
+	[[nodiscard]] HistoryArena::Stats arenaStats() const;
+
+	// Loaded histories are unloaded in least recently viewed order when
+	// their estimated size goes over the budget. Opened and pinned
+	// histories are never unloaded this way.
+	//
+	// Unloading destroys the views of a history, its items stay, because
+	// the chat list, replies and notifications keep pointers to them.
+	// So only the views count against the budget, the items are
+	// estimated and reported separately.
+	struct ResidentStats {
+		int64 viewsSize = 0;
+		int64 itemsSize = 0;
+		int64 budget = 0;
+		int histories = 0;
+		int evictions = 0;
+	};
+	void historyOpened(not_null<History*> history);
+	void historyClosed(not_null<History*> history);
+	void residentViewAdded(not_null<History*> history);
+	void residentViewRemoved(not_null<History*> history);
+	void setResidentBudget(int64 viewsSize);
+	[[nodiscard]] ResidentStats residentStats() const;
+
 	void readInbox(not_null<History*> history);
 	void readInboxTill(not_null<HistoryItem*> item);
 	void readInboxTill(not_null<History*> history, MsgId tillId);
@@ -217,6 +248,10 @@ private:
 #endif
 	void postponeRequestDialogEntries();
 
+	[[nodiscard]] bool canUnloadResident(not_null<History*> history);
+	void checkResidentBudget();
+	void releaseEmptySlabs();
+
 	void sendDialogRequests();
 
 	[[nodiscard]] bool isCreatingTopic(
@@ -227,6 +262,9 @@ private:
 
 	const not_null<Session*> _owner;
 
+	// Before _map, so that the histories are destroyed first.
+	HistoryArena _itemsArena;
+	HistoryArena _viewsArena;
 	std::unordered_map<PeerId, std::unique_ptr<History>> _map;
 	base::flat_map<not_null<History*>, State> _states;
 	base::flat_map<int, not_null<History*>> _historyByRequest;
@@ -243,6 +281,14 @@ private:
 
 	base::flat_set<not_null<History*>> _fakeChatListRequests;
 
+	base::flat_map<not_null<History*>, int> _opened;
+	base::flat_map<not_null<History*>, crl::time> _lastViewed;
+	base::flat_map<not_null<History*>, int> _residentViews;
+	int64 _residentViewsTotal = 0;
+	int64 _residentBudget = 0;
+	int _residentEvictions = 0;
+	base::Timer _residentTimer;
+
 	base::flat_map<
 		GroupRequestKey,
 		ChatListGroupRequest> _chatListGroupRequests;
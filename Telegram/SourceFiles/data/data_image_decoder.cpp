@@ -0,0 +1,86 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "data/data_image_decoder.h"
+
+#include "ui/image/image_prepare.h"
+
+namespace Data {
+namespace {
+
+constexpr auto kMaxRunning = 2;
+constexpr auto kLogWaitedThreshold = crl::time(50);
+
+} // namespace
+
+ImageDecoder::ImageDecoder() = default;
+
+ImageDecoder::~ImageDecoder() = default;
+
+void ImageDecoder::request(
+		Key key,
+		const QByteArray &bytes,
+		Done done) {
+	auto &task = _tasks[key];
+	if (task.bytes.isEmpty()) {
+		task.bytes = bytes;
+		task.requested = crl::now();
+	}
+	task.priority = ++_priority;
+	task.callbacks.push_back(std::move(done));
+	schedule();
+}
+
+void ImageDecoder::schedule() {
+	while (_running < kMaxRunning) {
+		auto best = (Task*)nullptr;
+		auto bestKey = (const void*)nullptr;
+		for (auto &[key, task] : _tasks) {
+			if (!task.running
+				&& (!best || best->priority < task.priority)) {
+				best = &task;
+				bestKey = key;
+			}
+		}
+		if (!best) {
+			return;
+		}
+		best->running = true;
+		++_running;
+
+		const auto waited = crl::now() - best->requested;
+		if (waited > _waitedMax && waited > kLogWaitedThreshold) {
+			_waitedMax = waited;
+			DEBUG_LOG(("Image Decoder: New max wait %1ms, queued %2."
+				).arg(waited
+				).arg(_tasks.size()));
+		}
+
+		const auto key = Key(bestKey);
+		crl::async([=, weak = base::make_weak(this), bytes = best->bytes] {
+			auto image = Images::Read({ .content = bytes }).image;
+			crl::on_main(weak, [=, image = std::move(image)]() mutable {
+				finish(key, std::move(image));
+			});
+		});
+	}
+}
+
+void ImageDecoder::finish(Key key, QImage &&image) {
+	--_running;
+	const auto i = _tasks.find(key);
+	if (i != end(_tasks)) {
+		const auto callbacks = base::take(i->second.callbacks);
+		_tasks.erase(i);
+		for (const auto &callback : callbacks) {
+			callback(image);
+		}
+	}
+	schedule();
+}
+
+} // namespace Data
@@ -0,0 +1,50 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+#include "base/weak_ptr.h"
+
+namespace Data {
+
+// Decodes small images (like inline thumbnails) off the main thread.
+//
+// Not more than a few images are decoded at the same time, the images
+// that were requested most recently are decoded first, because they're
+// the closest to the viewport. Requests for an image that is already
+// being decoded are merged into the existing one.
+class ImageDecoder final : public base::has_weak_ptr {
+public:
+	using Key = not_null<const void*>;
+	using Done = Fn<void(QImage)>;
+
+	ImageDecoder();
+	~ImageDecoder();
+
+	void request(Key key, const QByteArray &bytes, Done done);
+
+private:
+	struct Task {
+		QByteArray bytes;
+		std::vector<Done> callbacks;
+		uint64 priority = 0;
+		crl::time requested = 0;
+		bool running = false;
+	};
+
+	void schedule();
+	void finish(Key key, QImage &&image);
+
+	base::flat_map<Key, Task> _tasks;
+	uint64 _priority = 0;
+	int _running = 0;
+
+	crl::time _waitedMax = 0;
+
+};
+
+} // namespace Data
@@ -11,6 +11,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_session.h"
 #include "data/data_file_origin.h"
 #include "data/data_auto_download.h"
+#include "data/data_image_decoder.h"
 #include "main/main_session.h"
 #include "main/main_session_settings.h"
 #include "history/history_item.h"
@@ -51,6 +52,38 @@ Image *PhotoMedia::thumbnailInline() const {
 	return _inlineThumbnail.get();
 }
 
+Image *PhotoMedia::thumbnailInlineAsync() const {
+	// Requested only once, the pending request is not raised in the
+	// decoder queue on each paint until the image arrives.
+	if (!_inlineThumbnail && !_inlineThumbnailRequested) {
+		const auto bytes = _owner->inlineThumbnailBytes();
+		if (!bytes.isEmpty()) {
+			_inlineThumbnailRequested = true;
+			const auto photo = _owner;
+			auto done = [=](QImage image) {
+				if (image.isNull()) {
+					photo->clearInlineThumbnailBytes();
+				} else if (const auto active = photo->activeMediaView()) {
+					active->setInlineThumbnail(std::move(image));
+				}
+			};
+			_owner->owner().imageDecoder().request(
+				_owner,
+				bytes,
+				std::move(done));
+		}
+	}
+	return _inlineThumbnail.get();
+}
+
+void PhotoMedia::setInlineThumbnail(QImage image) {
+	if (_inlineThumbnail) {
+		return;
+	}
+	_inlineThumbnail = std::make_unique<Image>(std::move(image));
+	_owner->session().notifyDownloaderTaskFinished();
+}
+
 Image *PhotoMedia::image(PhotoSize size) const {
 	if (const auto resolved = resolveLoadedImage(size)) {
 		return resolved->data.get();
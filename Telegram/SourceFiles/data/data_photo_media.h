@@ -23,6 +23,10 @@ public:
 
 	[[nodiscard]] Image *thumbnailInline() const;
 
+	// Decodes in the background, returns nullptr until it is done.
+	[[nodiscard]] Image *thumbnailInlineAsync() const;
+	void setInlineThumbnail(QImage image);
+
 	[[nodiscard]] Image *image(PhotoSize size) const;
 	[[nodiscard]] QByteArray imageBytes(PhotoSize size) const;
 	[[nodiscard]] QSize size(PhotoSize size) const;
@@ -65,6 +69,7 @@ private:
 	// In case this is a problem the ~Gif code should be rewritten.
 	const not_null<PhotoData*> _owner;
 	mutable std::unique_ptr<Image> _inlineThumbnail;
+	mutable bool _inlineThumbnailRequested = false;
 	std::array<PhotoImage, kPhotoSizeCount>  _images;
 	QByteArray _videoBytesSmall;
 	QByteArray _videoBytesLarge;
@@ -0,0 +1,49 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "data/data_search_index.h"
+
+namespace Data {
+
+QString SearchIndexKey(const QString &word) {
+	return word.mid(0, kSearchIndexPrefixLength);
+}
+
+base::flat_set<QString> SearchIndexKeys(
+		const base::flat_set<QString> &words) {
+	auto result = base::flat_set<QString>();
+	for (const auto &word : words) {
+		const auto length = std::min(
+			int(word.size()),
+			kSearchIndexPrefixLength);
+		for (auto i = 1; i <= length; ++i) {
+			result.emplace(word.mid(0, i));
+		}
+	}
+	return result;
+}
+
+bool SearchIndexMatches(
+		const base::flat_set<QString> &words,
+		const QStringList &query) {
+	const auto found = [&](const QString &word) {
+		for (const auto &name : words) {
+			if (name.startsWith(word)) {
+				return true;
+			}
+		}
+		return false;
+	};
+	for (const auto &word : query) {
+		if (!word.isEmpty() && !found(word)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+} // namespace Data
@@ -0,0 +1,170 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+#include <unordered_map>
+
+namespace Data {
+
+// Name words are indexed by all their prefixes up to this length.
+inline constexpr auto kSearchIndexPrefixLength = 3;
+
+[[nodiscard]] QString SearchIndexKey(const QString &word);
+[[nodiscard]] base::flat_set<QString> SearchIndexKeys(
+	const base::flat_set<QString> &words);
+[[nodiscard]] bool SearchIndexMatches(
+	const base::flat_set<QString> &words,
+	const QStringList &query);
+
+// Incremental prefix index of items by their (normalized) name words.
+//
+// Each item is put into one bucket per distinct word prefix of length
+// 1..kSearchIndexPrefixLength, so a query only verifies the items from
+// the smallest bucket matching one of its words. Buckets are hashed by
+// their prefix, so insertion is amortized O(words). Removal only marks
+// bucket entries as stale, stale entries are dropped when a bucket becomes
+// mostly stale.
+template <typename Item>
+class SearchIndex final {
+public:
+	void add(Item item, const base::flat_set<QString> &words);
+	void remove(Item item);
+	void clear();
+
+	[[nodiscard]] bool contains(Item item) const {
+		return _items.contains(item);
+	}
+	[[nodiscard]] int size() const {
+		return int(_items.size());
+	}
+	[[nodiscard]] bool empty() const {
+		return _items.empty();
+	}
+
+	// Items having a name word starting with each of the query words,
+	// in the order they were added to the index.
+	[[nodiscard]] std::vector<Item> find(const QStringList &query) const;
+
+private:
+	struct Entry {
+		base::flat_set<QString> words;
+		base::flat_set<QString> keys;
+		uint32 generation = 0;
+	};
+	struct BucketEntry {
+		Item item;
+		uint32 generation = 0;
+	};
+	struct Bucket {
+		std::vector<BucketEntry> list;
+		int stale = 0;
+	};
+
+	[[nodiscard]] bool alive(const BucketEntry &entry) const;
+	void compact(Bucket &bucket);
+
+	std::unordered_map<Item, Entry> _items;
+	std::unordered_map<QString, Bucket> _buckets;
+	uint32 _generation = 0;
+
+};
+
+template <typename Item>
+void SearchIndex<Item>::add(
+		Item item,
+		const base::flat_set<QString> &words) {
+	remove(item);
+	if (words.empty()) {
+		return;
+	}
+	auto &entry = _items[item];
+	entry.words = words;
+	entry.keys = SearchIndexKeys(words);
+	entry.generation = ++_generation;
+	for (const auto &key : entry.keys) {
+		_buckets[key].list.push_back({ item, entry.generation });
+	}
+}
+
+template <typename Item>
+void SearchIndex<Item>::remove(Item item) {
+	const auto i = _items.find(item);
+	if (i == end(_items)) {
+		return;
+	}
+	const auto keys = std::move(i->second.keys);
+	_items.erase(i);
+	for (const auto &key : keys) {
+		const auto j = _buckets.find(key);
+		if (j == end(_buckets)) {
+			continue;
+		}
+		auto &bucket = j->second;
+		if (++bucket.stale == int(bucket.list.size())) {
+			_buckets.erase(j);
+		} else if (bucket.stale * 2 > int(bucket.list.size())) {
+			compact(bucket);
+		}
+	}
+}
+
+template <typename Item>
+void SearchIndex<Item>::clear() {
+	_items.clear();
+	_buckets.clear();
+}
+
+template <typename Item>
+bool SearchIndex<Item>::alive(const BucketEntry &entry) const {
+	const auto i = _items.find(entry.item);
+	return (i != end(_items)) && (i->second.generation == entry.generation);
+}
+
+template <typename Item>
+void SearchIndex<Item>::compact(Bucket &bucket) {
+	bucket.list.erase(ranges::remove_if(bucket.list, [&](
+			const BucketEntry &entry) {
+		return !alive(entry);
+	}), end(bucket.list));
+	bucket.stale = 0;
+}
+
+template <typename Item>
+std::vector<Item> SearchIndex<Item>::find(const QStringList &query) const {
+	auto minimal = (const Bucket*)nullptr;
+	for (const auto &word : query) {
+		if (word.isEmpty()) {
+			continue;
+		}
+		const auto i = _buckets.find(SearchIndexKey(word));
+		if (i == end(_buckets)) {
+			// Some word can't be found in any item.
+			return {};
+		} else if (!minimal
+			|| (minimal->list.size() - minimal->stale
+				> i->second.list.size() - i->second.stale)) {
+			minimal = &i->second;
+		}
+	}
+	auto result = std::vector<Item>();
+	if (!minimal) {
+		return result;
+	}
+	result.reserve(minimal->list.size() - minimal->stale);
+	for (const auto &entry : minimal->list) {
+		const auto i = _items.find(entry.item);
+		if (i == end(_items) || i->second.generation != entry.generation) {
+			continue;
+		} else if (SearchIndexMatches(i->second.words, query)) {
+			result.push_back(entry.item);
+		}
+	}
+	return result;
+}
+
+} // namespace Data
@@ -90,6 +90,7 @@ class ForumIcons;
 class ChatFilters;
 class CloudThemes;
 class Streaming;
+class ImageDecoder;
 class MediaRotation;
 class Histories;
 class DocumentMedia;
@@ -162,6 +163,9 @@ public:
 	[[nodiscard]] MediaRotation &mediaRotation() const {
 		return *_mediaRotation;
 	}
+	[[nodiscard]] ImageDecoder &imageDecoder() const {
+		return *_imageDecoder;
+	}
 	[[nodiscard]] Histories &histories() const {
 		return *_histories;
 	}
@@ -1219,6 +1223,7 @@ private:
 	const std::unique_ptr<SendActionManager> _sendActionManager;
 	const std::unique_ptr<Streaming> _streaming;
 	const std::unique_ptr<MediaRotation> _mediaRotation;
+	const std::unique_ptr<ImageDecoder> _imageDecoder;
 	const std::unique_ptr<Histories> _histories;
 	const std::unique_ptr<Stickers> _stickers;
 	std::unique_ptr<SponsoredMessages> _sponsoredMessages;
@@ -9,6 +9,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 
 #include "dialogs/dialogs_entry.h"
 #include "dialogs/dialogs_list.h"
+#include "data/data_search_index.h"
 
 class History;
 
@@ -95,6 +96,7 @@ private:
 	FilterId _filterId = 0;
 	List _list, _empty;
 	base::flat_map<QChar, List> _index;
+	Data::SearchIndex<not_null<Entry*>> _wordsIndex;
 
 };
 
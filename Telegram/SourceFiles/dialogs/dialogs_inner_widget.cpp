@@ -554,6 +554,12 @@ void InnerWidget::changeOpenedForum(Data::Forum *forum) {
 }
 
 void InnerWidget::paintEvent(QPaintEvent *e) {
+	const auto paintStarted = _paintStats.start();
+	auto paintedRows = 0;
+	const auto statsGuard = gsl::finally([&] {
+		_paintStats.finish(paintStarted, paintedRows, e->rect());
+	});
+
 	Painter p(this);
 
 	p.setInactive(
@@ -610,6 +616,7 @@ void InnerWidget::paintEvent(QPaintEvent *e) {
 			&& _selectedTopicJump
 			&& (!_pressed || _pressedTopicJump);
 		Ui::RowPainter::Paint(p, row, validateVideoUserpic(row), context);
+		++paintedRows;
 	};
 	if (_state == WidgetState::Default) {
 		const auto collapsedSkip = collapsedRowsOffset();
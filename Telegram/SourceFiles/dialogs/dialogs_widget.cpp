@@ -42,6 +42,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "api/api_chat_filters.h"
 #include "apiwrap.h"
 #include "base/event_filter.h"
+#include "base/call_delayed.h"
 #include "core/application.h"
 #include "core/update_checker.h"
 #include "core/shortcuts.h"
@@ -91,6 +92,8 @@ using namespace Tdb;
 
 constexpr auto kSearchPerPage = 50;
 constexpr auto kStoriesExpandDuration = crl::time(200);
+constexpr auto kBenchmarkFramesLimit = 512;
+constexpr auto kBenchmarkFrameDelay = crl::time(100);
 
 base::options::toggle OptionForumHideChatsList({
 	.id = kOptionForumHideChatsList,
@@ -1405,6 +1408,97 @@ void Widget::jumpToTop(bool belowPinned) {
 	}
 }
 
+struct Widget::PaintBenchmark {
+	Fn<void(QString)> done;
+	std::vector<crl::profile_time> durations;
+	int scrollTop = 0;
+};
+
+bool Widget::benchmarkPaint(Fn<void(QString)> done) {
+	if (_paintBenchmark
+		|| _inner->width() <= 0
+		|| _scroll->height() <= 0) {
+		return false;
+	}
+	_paintBenchmark = std::make_unique<PaintBenchmark>(PaintBenchmark{
+		.done = std::move(done),
+		.scrollTop = _scroll->scrollTop(),
+	});
+	benchmarkPaintScroll(0);
+	return true;
+}
+
+void Widget::benchmarkPaintScroll(int top) {
+	_scroll->scrollToY(top);
+
+	// The list is painted on screen after scrolling, which requests the
+	// userpics of the shown rows. Rendering right away would measure the
+	// rows with userpic placeholders, so give the userpics time to load.
+	base::call_delayed(kBenchmarkFrameDelay, this, [=] {
+		benchmarkPaintFrame();
+	});
+}
+
+void Widget::benchmarkPaintFrame() {
+	const auto width = _inner->width();
+	const auto height = _scroll->height();
+	if (width <= 0 || height <= 0) {
+		benchmarkPaintFinish();
+		return;
+	}
+	const auto ratio = style::DevicePixelRatio();
+	auto frame = QImage(
+		QSize(width, height) * ratio,
+		QImage::Format_ARGB32_Premultiplied);
+	frame.setDevicePixelRatio(ratio);
+	frame.fill(Qt::transparent);
+
+	const auto shown = _scroll->scrollTop();
+	const auto started = crl::profile();
+	_inner->render(&frame, QPoint(), QRegion(0, shown, width, height));
+
+	auto &durations = _paintBenchmark->durations;
+	durations.push_back(crl::profile() - started);
+	if (shown >= _scroll->scrollTopMax()
+		|| int(durations.size()) >= kBenchmarkFramesLimit) {
+		benchmarkPaintFinish();
+	} else {
+		benchmarkPaintScroll(shown + std::max(height / 4, 1));
+	}
+}
+
+void Widget::benchmarkPaintFinish() {
+	const auto benchmark = base::take(_paintBenchmark);
+	_scroll->scrollToY(benchmark->scrollTop);
+
+	auto &durations = benchmark->durations;
+	const auto frames = int(durations.size());
+	if (!frames) {
+		benchmark->done(QString());
+		return;
+	}
+	const auto total = ranges::accumulate(
+		durations,
+		crl::profile_time(0));
+	ranges::sort(durations);
+	const auto percentile = [&](int value) {
+		return durations[std::min(frames * value / 100, frames - 1)];
+	};
+	const auto summary = QString(
+		"%1 frames, %2 us average, %3 us median, %4 us p95, %5 us max."
+	).arg(frames
+	).arg(total / frames
+	).arg(percentile(50)
+	).arg(percentile(95)
+	).arg(durations.back());
+	LOG(("Dialogs Benchmark: %1x%2, list height %3, %4"
+		).arg(_inner->width()
+		).arg(_scroll->height()
+		).arg(_inner->height()
+		).arg(summary));
+	benchmark->done(summary);
+}
+
 void Widget::raiseWithTooltip() {
 	raise();
 	if (_stories) {
@@ -110,6 +110,11 @@ public:
 	void jumpToTop(bool belowPinned = false);
 	void raiseWithTooltip();
 
+	// Scrolls through the whole list rendering it offscreen, logs the
+	// frame times and passes a short summary of them to the callback.
+	// Returns false if the list is not shown or is already benchmarked.
+	bool benchmarkPaint(Fn<void(QString)> done);
+
 	void startWidthAnimation();
 	void stopWidthAnimation();
 
@@ -149,6 +154,8 @@ protected:
 	void paintEvent(QPaintEvent *e) override;
 
 private:
+	struct PaintBenchmark;
+
 	void chosenRow(const ChosenRow &row);
 	void listScrollUpdated();
 	void cancelSearchInChat();
@@ -162,6 +169,10 @@ private:
 
 	void slideFinished();
 
+	void benchmarkPaintScroll(int top);
+	void benchmarkPaintFrame();
+	void benchmarkPaintFinish();
+
 #if 0 // mtp
 	void searchReceived(
 		SearchRequestType type,
@@ -400,6 +411,8 @@ private:
 	rpl::variable<PeerId> _childListPeerId;
 	std::unique_ptr<Ui::RpWidget> _hideChildListCanvas;
 
+	std::unique_ptr<PaintBenchmark> _paintBenchmark;
+
 };
 
 } // namespace Dialogs
@@ -565,6 +565,14 @@ not_null<HistoryItem*> History::insertItem(
 	return result;
 }
 
+not_null<HistoryArena*> History::itemsArena() const {
+	return owner().histories().itemsArena();
+}
+
+not_null<HistoryArena*> History::viewsArena() const {
+	return owner().histories().viewsArena();
+}
+
 void History::destroyMessage(not_null<HistoryItem*> item) {
 	Expects(item->isHistoryEntry() || !item->mainView());
 
@@ -644,6 +652,10 @@ void History::unpinMessagesFor(MsgId topicRootId) {
 			Storage::SharedMediaRemoveAll(
 				peer->id,
 				Storage::SharedMediaType::Pinned));
+		session().local().setSharedMediaCount(
+			peer->id,
+			Storage::SharedMediaType::Pinned,
+			0);
 		setHasPinnedMessages(false);
 		if (const auto forum = peer->forum()) {
 			forum->enumerateTopics([](not_null<Data::ForumTopic*> topic) {
@@ -2687,6 +2699,7 @@ void History::setNotLoadedAtBottom() {
 void History::clearSharedMedia() {
 	session().storage().remove(
 		Storage::SharedMediaRemoveAll(peer->id));
+	session().local().removeSharedMediaCounts(peer->id);
 }
 
 void History::setLastServerMessage(HistoryItem *item) {
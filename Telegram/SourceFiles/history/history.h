@@ -27,6 +27,7 @@ class History;
 class HistoryBlock;
 class HistoryTranslation;
 class HistoryItem;
+class HistoryArena;
 struct HistoryMessageMarkupData;
 class HistoryMainElementDelegateMixin;
 struct LanguageId;
@@ -140,11 +141,14 @@ public:
 	not_null<HistoryItem*> makeMessage(Args &&...args) {
 		return static_cast<HistoryItem*>(
 			insertItem(
-				std::make_unique<HistoryItem>(
+				std::unique_ptr<HistoryItem>(new (itemsArena()) HistoryItem(
 					this,
-					std::forward<Args>(args)...)).get());
+					std::forward<Args>(args)...))).get());
 	}
 
+	[[nodiscard]] not_null<HistoryArena*> itemsArena() const;
+	[[nodiscard]] not_null<HistoryArena*> viewsArena() const;
+
 	void destroyMessage(not_null<HistoryItem*> item);
 	void destroyMessagesByDates(TimeId minDate, TimeId maxDate);
 	void destroyMessagesByTopic(MsgId topicRootId);
@@ -0,0 +1,215 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "history/history_arena.h"
+
+#include <new>
+
+namespace {
+
+constexpr auto kSlabSize = std::size_t(64 * 1024);
+constexpr auto kGranularity = std::size_t(16);
+constexpr auto kKeepEmptySlabs = 1;
+
+[[nodiscard]] int ClassIndex(std::size_t size) {
+	return int((size + kGranularity - 1) / kGranularity) - 1;
+}
+
+} // namespace
+
+struct alignas(64) HistoryArena::Slab {
+	struct FreeObject {
+		FreeObject *next = nullptr;
+	};
+
+	HistoryArena *arena = nullptr; // Null after the arena is destroyed.
+	Slab *previous = nullptr;
+	Slab *next = nullptr;
+	FreeObject *free = nullptr;
+	char *untouched = nullptr;
+	char *till = nullptr;
+	std::size_t objectSize = 0;
+	int used = 0;
+	int capacity = 0;
+
+	[[nodiscard]] static not_null<Slab*> From(void *pointer) {
+		return reinterpret_cast<Slab*>(
+			reinterpret_cast<std::uintptr_t>(pointer) & ~(kSlabSize - 1));
+	}
+
+	void link(Slab *&list) {
+		previous = nullptr;
+		next = list;
+		if (next) {
+			next->previous = this;
+		}
+		list = this;
+	}
+
+	void unlink(Slab *&list) {
+		if (previous) {
+			previous->next = next;
+		} else {
+			list = next;
+		}
+		if (next) {
+			next->previous = previous;
+		}
+		previous = next = nullptr;
+	}
+
+	static void Destroy(not_null<Slab*> slab) {
+		slab->~Slab();
+		::operator delete(slab.get(), std::align_val_t(kSlabSize));
+	}
+};
+
+HistoryArena::~HistoryArena() {
+	for (auto &sizeClass : _classes) {
+		for (const auto list : { sizeClass.available, sizeClass.full }) {
+			for (auto slab = list; slab;) {
+				const auto next = slab->next;
+				if (slab->used) {
+					slab->arena = nullptr;
+				} else {
+					Slab::Destroy(slab);
+				}
+				slab = next;
+			}
+		}
+	}
+}
+
+void *HistoryArena::allocate(std::size_t size) {
+	++_allocations;
+	if (!size || size > kClassesCount * kGranularity) {
+		return ::operator new(size);
+	}
+	const auto index = ClassIndex(size);
+	auto &sizeClass = _classes[index];
+	if (!sizeClass.available) {
+		createSlab(sizeClass, (index + 1) * kGranularity);
+	}
+	const auto slab = sizeClass.available;
+	if (!slab->used) {
+		--sizeClass.emptySlabs;
+	}
+	auto result = (void*)nullptr;
+	if (const auto free = slab->free) {
+		slab->free = free->next;
+		result = free;
+	} else {
+		Assert(slab->untouched != slab->till);
+		result = slab->untouched;
+		slab->untouched += slab->objectSize;
+	}
+	if (++slab->used == slab->capacity) {
+		slab->unlink(sizeClass.available);
+		slab->link(sizeClass.full);
+	}
+	++_objects;
+	_usedBytes += slab->objectSize;
+	return result;
+}
+
+void HistoryArena::Free(void *pointer, std::size_t size) {
+	if (!pointer) {
+		return;
+	} else if (!size || size > kClassesCount * kGranularity) {
+		::operator delete(pointer);
+		return;
+	}
+	const auto slab = Slab::From(pointer);
+	if (const auto arena = slab->arena) {
+		arena->free(slab, pointer);
+	} else if (!--slab->used) {
+		Slab::Destroy(slab);
+	}
+}
+
+void HistoryArena::freeUnsized(void *pointer) {
+	if (!pointer) {
+		return;
+	}
+	const auto slab = Slab::From(pointer);
+	for (auto &sizeClass : _classes) {
+		for (const auto list : { sizeClass.available, sizeClass.full }) {
+			for (auto i = list; i; i = i->next) {
+				if (i == slab.get()) {
+					free(slab, pointer);
+					return;
+				}
+			}
+		}
+	}
+	::operator delete(pointer);
+}
+
+void HistoryArena::free(not_null<Slab*> slab, void *pointer) {
+	auto &sizeClass = _classes[ClassIndex(slab->objectSize)];
+	if (slab->used == slab->capacity) {
+		slab->unlink(sizeClass.full);
+		slab->link(sizeClass.available);
+	}
+	slab->free = new (pointer) Slab::FreeObject{ slab->free };
+	--_objects;
+	_usedBytes -= slab->objectSize;
+	if (--slab->used) {
+		return;
+	} else if (sizeClass.emptySlabs < kKeepEmptySlabs) {
+		++sizeClass.emptySlabs;
+		return;
+	}
+	destroySlab(sizeClass, slab);
+}
+
+void HistoryArena::releaseEmpty() {
+	for (auto &sizeClass : _classes) {
+		for (auto slab = sizeClass.available; slab;) {
+			const auto next = slab->next;
+			if (!slab->used) {
+				destroySlab(sizeClass, slab);
+			}
+			slab = next;
+		}
+		sizeClass.emptySlabs = 0;
+	}
+}
+
+void HistoryArena::createSlab(SizeClass &sizeClass, std::size_t objectSize) {
+	const auto memory = ::operator new(
+		kSlabSize,
+		std::align_val_t(kSlabSize));
+	const auto slab = new (memory) Slab();
+	const auto begin = static_cast<char*>(memory) + sizeof(Slab);
+	slab->arena = this;
+	slab->objectSize = objectSize;
+	slab->capacity = int((kSlabSize - sizeof(Slab)) / objectSize);
+	slab->untouched = begin;
+	slab->till = begin + slab->capacity * objectSize;
+	slab->link(sizeClass.available);
+	++sizeClass.emptySlabs;
+	++_slabs;
+}
+
+void HistoryArena::destroySlab(SizeClass &sizeClass, not_null<Slab*> slab) {
+	Expects(!slab->used);
+
+	slab->unlink(sizeClass.available);
+	Slab::Destroy(slab);
+	--_slabs;
+}
+
+HistoryArena::Stats HistoryArena::stats() const {
+	return {
+		.allocations = _allocations,
+		.objects = _objects,
+		.slabs = _slabs,
+		.usedBytes = _usedBytes,
+		.reservedBytes = _slabs * int64(kSlabSize),
+	};
+}
@@ -0,0 +1,66 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+// Storage for the objects that all histories of a session create and
+// destroy in bulk when they are loaded and unloaded: items and views.
+//
+// Objects of the same size class are placed in 64 KB slabs shared by all
+// histories, so a chat with only its last message loaded doesn't reserve
+// a slab of its own. A slab goes back to the system once all objects in
+// it are destroyed, except for one kept empty slab of each size class
+// that is returned by releaseEmpty(). Objects may outlive the arena,
+// their slabs are released when the last of them is destroyed.
+// Main thread only.
+class HistoryArena final {
+public:
+	HistoryArena() = default;
+	HistoryArena(const HistoryArena &other) = delete;
+	HistoryArena &operator=(const HistoryArena &other) = delete;
+	~HistoryArena();
+
+	struct Stats {
+		int64 allocations = 0;
+		int objects = 0;
+		int slabs = 0;
+		int64 usedBytes = 0;
+		int64 reservedBytes = 0;
+	};
+
+	[[nodiscard]] void *allocate(std::size_t size);
+	static void Free(void *pointer, std::size_t size);
+
+	// For a pointer from allocate() with an unknown size, for example
+	// from a placement delete after a throwing constructor. Slow.
+	void freeUnsized(void *pointer);
+
+	void releaseEmpty();
+
+	[[nodiscard]] Stats stats() const;
+
+private:
+	struct Slab;
+	struct SizeClass {
+		Slab *available = nullptr; // Slabs with at least one free object.
+		Slab *full = nullptr;
+		int emptySlabs = 0;
+	};
+
+	static constexpr auto kClassesCount = 64;
+
+	void free(not_null<Slab*> slab, void *pointer);
+	void createSlab(SizeClass &sizeClass, std::size_t objectSize);
+	void destroySlab(SizeClass &sizeClass, not_null<Slab*> slab);
+
+	std::array<SizeClass, kClassesCount> _classes;
+	int64 _allocations = 0;
+	int _objects = 0;
+	int _slabs = 0;
+	int64 _usedBytes = 0;
+
+};
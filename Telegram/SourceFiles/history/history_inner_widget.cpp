@@ -1242,6 +1242,7 @@ void HistoryInner::paintEvent(QPaintEvent *e) {
 				selfromy - mtop,
 				seltoy - mtop);
 			context.highlight = _widget->itemHighlight(view->data());
+			view->warmUpText();
 			view->draw(p, context);
 			processPainted(view, top, height);
 
@@ -1288,6 +1289,7 @@ void HistoryInner::paintEvent(QPaintEvent *e) {
 					selfromy - htop,
 					seltoy - htop);
 				context.highlight = _widget->itemHighlight(item);
+				view->warmUpText();
 				view->draw(p, context);
 				processPainted(view, top, height);
 			}
@@ -3269,6 +3271,7 @@ void HistoryInner::visibleAreaUpdated(int top, int bottom) {
 			from,
 			till);
 	}
+	updateTextCooling();
 	checkActivation();
 
 	_emojiInteractions->visibleAreaUpdated(
@@ -3845,6 +3848,7 @@ void HistoryInner::mouseActionUpdate() {
 			if (base::IsAltPressed()) {
 				request.flags &= ~Ui::Text::StateRequest::Flag::LookupLink;
 			}
+			view->warmUpText();
 			dragState = view->textState(m, request);
 			_dragStateItem = session().data().message(dragState.itemId);
 			lnkhost = view;
@@ -4050,6 +4054,59 @@ int HistoryInner::historyScrollTop() const {
 	return ScrollMax;
 }
 
+void HistoryInner::updateTextCooling() {
+	const auto visibleAreaHeight = _visibleAreaBottom - _visibleAreaTop;
+	if (visibleAreaHeight <= 0
+		|| (_textCoolingTop >= 0
+			&& std::abs(_visibleAreaTop - _textCoolingTop)
+				< visibleAreaHeight)) {
+		return;
+	}
+	_textCoolingTop = _visibleAreaTop;
+
+	using HistoryView::kWarmTextPages;
+	using HistoryView::kColdTextPages;
+	const auto warmFrom = _visibleAreaTop
+		- kWarmTextPages * visibleAreaHeight;
+	const auto warmTill = _visibleAreaBottom
+		+ kWarmTextPages * visibleAreaHeight;
+	const auto coldFrom = _visibleAreaTop
+		- kColdTextPages * visibleAreaHeight;
+	const auto coldTill = _visibleAreaBottom
+		+ kColdTextPages * visibleAreaHeight;
+	const auto keepWarm = [&](not_null<Element*> view) {
+		// Text selection and mouse actions query the text of the item.
+		const auto item = view->data().get();
+		return (item == _mouseActionItem) || _selected.contains(item);
+	};
+	const auto update = [&](History *history, int top) {
+		if (!history || top < 0) {
+			return;
+		}
+		for (const auto &block : history->blocks) {
+			const auto blockTop = top + block->y();
+			const auto blockBottom = blockTop + block->height();
+			if (blockBottom <= coldFrom || blockTop >= coldTill) {
+				for (const auto &view : block->messages) {
+					if (!keepWarm(view.get())) {
+						view->coolDownText();
+					}
+				}
+			} else if (blockBottom > warmFrom && blockTop < warmTill) {
+				for (const auto &view : block->messages) {
+					const auto viewTop = blockTop + view->y();
+					const auto viewBottom = viewTop + view->height();
+					if (viewBottom > warmFrom && viewTop < warmTill) {
+						view->warmUpText();
+					}
+				}
+			}
+		}
+	};
+	update(_migrated, migratedTop());
+	update(_history, historyTop());
+}
+
 int HistoryInner::migratedTop() const {
 	return (_migrated && !_migrated->isEmpty()) ? _historyPaddingTop : -1;
 }
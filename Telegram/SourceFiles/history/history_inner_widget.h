@@ -131,6 +131,7 @@ public:
 	void setItemsRevealHeight(int revealHeight);
 	void changeItemsRevealHeight(int revealHeight);
 	void checkActivation();
+	void updateTextCooling();
 	void recountHistoryGeometry();
 	void updateSize();
 	void setShownPinned(HistoryItem *item);
@@ -458,6 +459,7 @@ private:
 	// Save visible area coords for painting / pressing userpics.
 	int _visibleAreaTop = 0;
 	int _visibleAreaBottom = 0;
+	int _textCoolingTop = -1;
 
 	// With migrated history we perhaps do not need to display
 	// the first _history message date (just skip it by height).
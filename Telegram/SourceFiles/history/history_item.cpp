@@ -19,6 +19,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "history/history_item_helpers.h"
 #include "history/history_unread_things.h"
 #include "history/history.h"
+#include "history/history_arena.h"
 #include "mtproto/mtproto_config.h"
 #include "media/clip/media_clip_reader.h"
 #include "ui/text/format_values.h"
@@ -145,6 +146,22 @@ void HistoryItem::HistoryItem::Destroyer::operator()(HistoryItem *value) {
 	}
 }
 
+void *HistoryItem::operator new(
+		std::size_t size,
+		not_null<HistoryArena*> arena) {
+	return arena->allocate(size);
+}
+
+void HistoryItem::operator delete(void *pointer, std::size_t size) {
+	HistoryArena::Free(pointer, size);
+}
+
+void HistoryItem::operator delete(
+		void *pointer,
+		not_null<HistoryArena*> arena) {
+	arena->freeUnsized(pointer);
+}
+
 struct HistoryItem::CreateConfig {
 	ReplyFields reply;
 
@@ -1314,13 +1331,13 @@ uint8 HistoryItem::colorIndex() const {
 std::unique_ptr<HistoryView::Element> HistoryItem::createView(
 		not_null<HistoryView::ElementDelegate*> delegate,
 		HistoryView::Element *replacing) {
+	const auto arena = _history->viewsArena();
 	if (isService()) {
-		return std::make_unique<HistoryView::Service>(
-			delegate,
-			this,
-			replacing);
+		return std::unique_ptr<HistoryView::Element>(
+			new (arena) HistoryView::Service(delegate, this, replacing));
 	}
-	return std::make_unique<HistoryView::Message>(delegate, this, replacing);
+	return std::unique_ptr<HistoryView::Element>(
+		new (arena) HistoryView::Message(delegate, this, replacing));
 }
 
 void HistoryItem::invalidateChatListEntry() {
@@ -29,6 +29,7 @@ class TLDmessageAnimatedEmoji;
 
 class HiddenSenderInfo;
 class History;
+class HistoryArena;
 struct HistoryMessageReply;
 struct HistoryMessageViews;
 struct HistoryMessageMarkupData;
@@ -212,6 +213,15 @@ public:
 		void operator()(HistoryItem *value);
 	};
 
+	// Items are allocated only in the arena of their session.
+	static void *operator new(
+		std::size_t size,
+		not_null<HistoryArena*> arena);
+	static void operator delete(void *pointer, std::size_t size);
+	static void operator delete(
+		void *pointer,
+		not_null<HistoryArena*> arena);
+
 	void dependencyItemRemoved(not_null<HistoryItem*> dependency);
 	void dependencyStoryRemoved(not_null<Data::Story*> dependency);
 	void updateDependencyItem();
@@ -75,7 +75,7 @@ Ui::ChatPaintHighlight ElementHighlighter::state(
 }
 
 ElementHighlighter::Highlight ElementHighlighter::computeHighlight(
-		not_null<const Element*> view,
+		not_null<Element*> view,
 		const TextWithEntities &part) {
 	const auto item = view->data();
 	const auto owner = &item->history()->owner();
@@ -88,6 +88,7 @@ ElementHighlighter::Highlight ElementHighlighter::computeHighlight(
 			if (part.empty()) {
 				return { leaderId, AddGroupItemSelection({}, index) };
 			} else if (const auto leaderView = _viewForItem(leader)) {
+				leaderView->warmUpText();
 				return {
 					leaderId,
 					leaderView->selectionFromQuote(item, part),
@@ -98,6 +99,7 @@ ElementHighlighter::Highlight ElementHighlighter::computeHighlight(
 	} else if (part.empty()) {
 		return { item->fullId() };
 	}
+	view->warmUpText();
 	return { item->fullId(), view->selectionFromQuote(item, part) };
 }
 
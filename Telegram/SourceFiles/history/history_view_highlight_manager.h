@@ -72,7 +72,7 @@ private:
 	};
 
 	[[nodiscard]] Highlight computeHighlight(
-		not_null<const Element*> view,
+		not_null<Element*> view,
 		const TextWithEntities &part);
 	void highlight(Highlight data);
 	void checkNextHighlight();
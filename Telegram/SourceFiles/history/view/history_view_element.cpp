@@ -21,6 +21,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "history/view/history_view_reply.h"
 #include "history/view/history_view_spoiler_click_handler.h"
 #include "history/history.h"
+#include "history/history_arena.h"
 #include "history/history_item.h"
 #include "history/history_item_components.h"
 #include "history/history_item_helpers.h"
@@ -43,6 +44,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "ui/item_text_options.h"
 #include "ui/painter.h"
 #include "data/data_session.h"
+#include "data/data_histories.h"
 #include "data/data_groups.h"
 #include "data/data_forum.h"
 #include "data/data_forum_topic.h"
@@ -505,6 +507,7 @@ Element::Element(
 	refreshMedia(replacing);
 	if (_context == Context::History) {
 		history()->setHasPendingResizedItems();
+		history()->owner().histories().residentViewAdded(history());
 	}
 	if (data->isFakeBotAbout() && !data->history()->peer->isRepliesChat()) {
 		AddComponents(FakeBotAboutTop::Bit());
@@ -550,6 +553,9 @@ void Element::setY(int y) {
 void Element::refreshDataIdHook() {
 }
 
+void Element::textWarmedUpHook() const {
+}
+
 void Element::clearSpecialOnlyEmoji() {
 	if (!(_flags & Flag::SpecialOnlyEmoji)) {
 		return;
@@ -573,7 +579,7 @@ void Element::hideSpoilers() {
 	}
 }
 
-void Element::customEmojiRepaint() {
+void Element::customEmojiRepaint() const {
 	if (!(_flags & Flag::CustomEmojiRepainting)) {
 		_flags |= Flag::CustomEmojiRepainting;
 		history()->owner().requestViewRepaint(this);
@@ -726,6 +732,7 @@ void Element::overrideMedia(std::unique_ptr<Media> media) {
 	_text = Ui::Text::String(st::msgMinWidth);
 	_textWidth = -1;
 	_textHeight = 0;
+	_flags &= ~(Flag::TextCold | Flag::TextHeightEstimated);
 
 	_media = std::move(media);
 	if (!pendingResize()) {
@@ -813,21 +820,28 @@ void Element::refreshMedia(Element *replacing) {
 }
 
 Ui::Text::IsolatedEmoji Element::isolatedEmoji() const {
+	ensureTextWarm();
 	return _text.toIsolatedEmoji();
 }
 
 Ui::Text::OnlyCustomEmoji Element::onlyCustomEmoji() const {
+	ensureTextWarm();
 	return _text.toOnlyCustomEmoji();
 }
 
 const Ui::Text::String &Element::text() const {
+	ensureTextWarm();
 	return _text;
 }
 
+int Element::textMaxWidth() const {
+	return (_flags & Flag::TextCold) ? _coldTextMaxWidth : _text.maxWidth();
+}
+
 OnlyEmojiAndSpaces Element::isOnlyEmojiAndSpaces() const {
 	if (data()->Has<HistoryMessageTranslation>()) {
 		return OnlyEmojiAndSpaces::No;
-	} else if (!_text.isEmpty()) {
+	} else if (!(_flags & Flag::TextCold) && !_text.isEmpty()) {
 		return _text.hasNotEmojiAndSpaces()
 			? OnlyEmojiAndSpaces::No
 			: OnlyEmojiAndSpaces::Yes;
@@ -839,10 +853,25 @@ OnlyEmojiAndSpaces Element::isOnlyEmojiAndSpaces() const {
 }
 
 int Element::textHeightFor(int textWidth) {
+	if (_flags & Flag::TextCold) {
+		// Text doesn't wrap when it fits, so only for narrower widths
+		// the last height is kept as an estimate.
+		if (_textWidth != textWidth) {
+			_textWidth = textWidth;
+			if (textWidth >= _coldTextMaxWidth) {
+				_textHeight = _coldTextMinHeight;
+				_flags &= ~Flag::TextHeightEstimated;
+			} else {
+				_flags |= Flag::TextHeightEstimated;
+			}
+		}
+		return _textHeight;
+	}
 	validateText();
 	if (_textWidth != textWidth) {
 		_textWidth = textWidth;
 		_textHeight = _text.countHeight(textWidth);
+		_flags &= ~Flag::TextHeightEstimated;
 	}
 	return _textHeight;
 }
@@ -988,6 +1017,9 @@ auto Element::contextDependentServiceText() -> TextWithLinks {
 }
 
 void Element::validateText() {
+	if (_flags & Flag::TextCold) {
+		warmUpText();
+	}
 	const auto item = data();
 	const auto &text = item->_text;
 	const auto media = item->media();
@@ -1020,6 +1052,21 @@ void Element::validateText() {
 void Element::setTextWithLinks(
 		const TextWithEntities &text,
 		const std::vector<ClickHandlerPtr> &links) {
+	const auto service = (_flags & Flag::ServiceMessage);
+	if (!service) {
+		clearSpecialOnlyEmoji();
+	}
+	fillText(text, links);
+	if (!service && !data()->media()) {
+		checkSpecialOnlyEmoji();
+		refreshMedia(nullptr);
+	}
+	FillTextWithAnimatedSpoilers(this, _text);
+}
+
+void Element::fillText(
+		const TextWithEntities &text,
+		const std::vector<ClickHandlerPtr> &links) const {
 	const auto context = Core::MarkedTextContext{
 		.session = &history()->session(),
 		.customEmojiRepaint = [=] { customEmojiRepaint(); },
@@ -1035,7 +1082,6 @@ void Element::setTextWithLinks(
 	} else {
 		const auto item = data();
 		const auto &options = Ui::ItemTextOptions(item);
-		clearSpecialOnlyEmoji();
 		_text.setMarkedText(st::messageTextStyle, text, options, context);
 		if (!item->_text.empty() && _text.isEmpty()){
 			// If server has allowed some text that we've trim-ed entirely,
@@ -1045,18 +1091,17 @@ void Element::setTextWithLinks(
 				{ u":-("_q },
 				Ui::ItemTextOptions(item));
 		}
-		if (!item->media()) {
-			checkSpecialOnlyEmoji();
-			refreshMedia(nullptr);
-		}
 	}
-	FillTextWithAnimatedSpoilers(this, _text);
 	_textWidth = -1;
 	_textHeight = 0;
 }
 
 void Element::validateTextSkipBlock(bool has, int width, int height) {
 	validateText();
+	applyTextSkipBlock(has, width, height);
+}
+
+void Element::applyTextSkipBlock(bool has, int width, int height) const {
 	if (!has) {
 		if (_text.removeSkipBlock()) {
 			_textWidth = -1;
@@ -1492,11 +1537,76 @@ void Element::itemTextUpdated() {
 	_text = Ui::Text::String(st::msgMinWidth);
 	_textWidth = -1;
 	_textHeight = 0;
+	_flags &= ~(Flag::TextCold | Flag::TextHeightEstimated);
 	if (_media && !data()->media()) {
 		refreshMedia(nullptr);
 	}
 }
 
+void Element::coolDownText() {
+	// Service messages are short, and their text depends on the context.
+	constexpr auto kKeepFlags = Flag::TextCold
+		| Flag::ServiceMessage
+		| Flag::SpecialOnlyEmoji
+		| Flag::MediaOverriden
+		| Flag::HeavyCustomEmoji;
+	if ((_flags & kKeepFlags)
+		|| this == Hovered()
+		|| this == Pressed()
+		|| this == HoveredLink()
+		|| this == PressedLink()
+		|| this == Moused()
+		|| pendingResize()
+		|| _textWidth < 0
+		|| _text.isEmpty()
+		|| _text.hasSpoilers()) {
+		return;
+	}
+	_coldTextMaxWidth = _text.maxWidth();
+	_coldTextMinHeight = _text.minHeight();
+	_text = Ui::Text::String(st::msgMinWidth);
+	_flags |= Flag::TextCold;
+}
+
+void Element::ensureTextWarm() const {
+	if (!(_flags & Flag::TextCold)) {
+		return;
+	}
+	_flags &= ~Flag::TextCold;
+
+	// Elements with spoilers, special emoji or overriden media are never
+	// cooled down, so only the text itself is prepared here again.
+	const auto width = _textWidth;
+	const auto height = _textHeight;
+	const auto item = data();
+	const auto media = item->media();
+	if (media && media->storyExpired() && !media->storyMention()) {
+		fillText(Ui::Text::Italic(tr::lng_forwarded_story_expired(tr::now)));
+	} else {
+		fillText(item->translatedTextWithLocalEntities());
+	}
+	textWarmedUpHook();
+
+	// The text is the same, so the cached height is valid if it was not
+	// estimated for a new width.
+	if (!(_flags & Flag::TextHeightEstimated)) {
+		_textWidth = width;
+		_textHeight = height;
+	}
+}
+
+void Element::warmUpText() {
+	ensureTextWarm();
+	if (_flags & Flag::TextHeightEstimated) {
+		// Resize later, lists may warm elements up while painting.
+		crl::on_main(this, [=] {
+			if ((_flags & Flag::TextHeightEstimated) && !pendingResize()) {
+				history()->owner().requestViewResize(this);
+			}
+		});
+	}
+}
+
 void Element::unloadHeavyPart() {
 	history()->owner().unregisterHeavyViewPart(this);
 	if (_media) {
@@ -1795,10 +1905,27 @@ Element::~Element() {
 	}
 	if (_context == Context::History) {
 		history()->owner().notifyViewRemoved(this);
+		history()->owner().histories().residentViewRemoved(history());
 	}
 	history()->owner().unregisterItemView(this);
 }
 
+void *Element::operator new(
+		std::size_t size,
+		not_null<HistoryArena*> arena) {
+	return arena->allocate(size);
+}
+
+void Element::operator delete(void *pointer, std::size_t size) {
+	HistoryArena::Free(pointer, size);
+}
+
+void Element::operator delete(
+		void *pointer,
+		not_null<HistoryArena*> arena) {
+	arena->freeUnsized(pointer);
+}
+
 void Element::Hovered(Element *view) {
 	HoveredElement = view;
 }
@@ -13,6 +13,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "base/weak_ptr.h"
 
 class History;
+class HistoryArena;
 class HistoryBlock;
 class HistoryItem;
 struct HistoryMessageReply;
@@ -65,6 +66,11 @@ enum class OnlyEmojiAndSpaces : char {
 	No,
 };
 
+// Lists keep the text of elements within kWarmTextPages visible heights
+// from the visible area warm and cool it down beyond kColdTextPages.
+constexpr auto kWarmTextPages = 2;
+constexpr auto kColdTextPages = 6;
+
 class Element;
 class ElementDelegate {
 public:
@@ -297,6 +303,8 @@ public:
 		TopicRootReply           = 0x0400,
 		MediaOverriden           = 0x0800,
 		HeavyCustomEmoji         = 0x1000,
+		TextCold                 = 0x2000,
+		TextHeightEstimated      = 0x4000,
 	};
 	using Flags = base::flags<Flag>;
 	friend inline constexpr auto is_flag_type(Flag) { return true; }
@@ -481,6 +489,15 @@ public:
 	virtual void unloadHeavyPart();
 	void checkHeavyPart();
 
+	// Cold elements far from the visible area keep only the text size.
+	// They are resized without preparing the text again, so their text
+	// height is estimated for widths where the text wraps. Text accessors
+	// prepare the text on demand, warmUpText() also schedules a resize
+	// if the height was estimated. Lists call it before elements come
+	// into view.
+	void coolDownText();
+	void warmUpText();
+
 	void paintCustomHighlight(
 		Painter &p,
 		const PaintContext &context,
@@ -505,7 +522,7 @@ public:
 
 	[[nodiscard]] virtual QRect innerGeometry() const = 0;
 
-	void customEmojiRepaint();
+	void customEmojiRepaint() const;
 	void prepareCustomEmojiPaint(
 		Painter &p,
 		const PaintContext &context,
@@ -534,6 +551,15 @@ public:
 
 	virtual ~Element();
 
+	// Views are allocated only in the arena of their session.
+	static void *operator new(
+		std::size_t size,
+		not_null<HistoryArena*> arena);
+	static void operator delete(void *pointer, std::size_t size);
+	static void operator delete(
+		void *pointer,
+		not_null<HistoryArena*> arena);
+
 	static void Hovered(Element *view);
 	[[nodiscard]] static Element *Hovered();
 	static void Pressed(Element *view);
@@ -557,16 +583,24 @@ protected:
 	[[nodiscard]] ClickHandlerPtr fromLink() const;
 
 	virtual void refreshDataIdHook();
+	virtual void textWarmedUpHook() const;
 
 	[[nodiscard]] const Ui::Text::String &text() const;
+	[[nodiscard]] int textMaxWidth() const;
 	[[nodiscard]] int textHeightFor(int textWidth);
 	void validateText();
 	void validateTextSkipBlock(bool has, int width, int height);
+	void applyTextSkipBlock(bool has, int width, int height) const;
 
 	void clearSpecialOnlyEmoji();
 	void checkSpecialOnlyEmoji();
 
 private:
+	void ensureTextWarm() const;
+	void fillText(
+		const TextWithEntities &text,
+		const std::vector<ClickHandlerPtr> &links = {}) const;
+
 	// This should be called only from previousInBlocksChanged()
 	// to add required bits to the Composer mask
 	// after that always use Has<DateBadge>().
@@ -607,6 +641,8 @@ private:
 	mutable Ui::Text::String _text;
 	mutable int _textWidth = -1;
 	mutable int _textHeight = 0;
+	int _coldTextMaxWidth = 0;
+	int _coldTextMinHeight = 0;
 
 	int _y = 0;
 	int _indexInBlock = -1;
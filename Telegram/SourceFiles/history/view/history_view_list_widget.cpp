@@ -1005,6 +1005,7 @@ void ListWidget::visibleTopBottomUpdated(
 		checkUnreadBarCreation();
 	}
 	updateVisibleTopItem();
+	updateTextCooling();
 	if (scrolledUp) {
 		_scrollDateCheck.call();
 	} else {
@@ -1021,6 +1022,38 @@ void ListWidget::applyUpdatedScrollState() {
 	checkMoveToOtherViewer();
 }
 
+void ListWidget::updateTextCooling() {
+	const auto visibleHeight = _visibleBottom - _visibleTop;
+	if (visibleHeight <= 0
+		|| (_textCoolingTop >= 0
+			&& std::abs(_visibleTop - _textCoolingTop) < visibleHeight)) {
+		return;
+	}
+	_textCoolingTop = _visibleTop;
+
+	const auto warmFrom = _visibleTop - kWarmTextPages * visibleHeight;
+	const auto warmTill = _visibleBottom + kWarmTextPages * visibleHeight;
+	const auto coldFrom = _visibleTop - kColdTextPages * visibleHeight;
+	const auto coldTill = _visibleBottom + kColdTextPages * visibleHeight;
+	const auto keepWarm = [&](not_null<Element*> view) {
+		// Text selection and mouse actions query the text of the item.
+		return (view == _overElement)
+			|| (view->data() == _selectedTextItem)
+			|| (view->data()->fullId() == _pressState.itemId);
+	};
+	for (const auto &view : _items) {
+		const auto top = view->y();
+		const auto bottom = top + view->height();
+		if (bottom <= coldFrom || top >= coldTill) {
+			if (!keepWarm(view)) {
+				view->coolDownText();
+			}
+		} else if (bottom > warmFrom && top < warmTill) {
+			view->warmUpText();
+		}
+	}
+}
+
 void ListWidget::updateVisibleTopItem() {
 	if (_visibleBottom == height()) {
 		_visibleTopItem = nullptr;
@@ -2109,6 +2142,7 @@ void ListWidget::paintEvent(QPaintEvent *e) {
 			context.outbg = view->hasOutLayout();
 			context.selection = itemRenderSelection(view);
 			context.highlight = _highlighter.state(item);
+			view->warmUpText();
 			view->draw(p, context);
 		}
 		if (_translateTracker) {
@@ -3463,6 +3497,7 @@ void ListWidget::mouseActionUpdate() {
 			return true;
 		});
 		if (!dragState.link) {
+			view->warmUpText();
 			dragState = view->textState(itemPoint, request);
 			_overItemExact = session().data().message(dragState.itemId);
 			lnkhost = view;
@@ -3065,6 +3065,13 @@ auto Message::verticalRepaintRange() const -> VerticalRepaintRange {
 	};
 }
 
+void Message::textWarmedUpHook() const {
+	applyTextSkipBlock(
+		hasTextSkipBlock(),
+		skipBlockWidth(),
+		skipBlockHeight());
+}
+
 void Message::refreshDataIdHook() {
 	if (_rightAction && base::take(_rightAction->link)) {
 		_rightAction->link = rightActionLink(_rightAction->lastPoint);
@@ -3083,7 +3090,7 @@ void Message::refreshDataIdHook() {
 
 int Message::plainMaxWidth() const {
 	return st::msgPadding.left()
-		+ (hasVisibleText() ? text().maxWidth() : 0)
+		+ (hasVisibleText() ? textMaxWidth() : 0)
 		+ st::msgPadding.right();
 }
 
@@ -4057,24 +4064,25 @@ QSize Message::performCountCurrentSize(int newWidth) {
 	return { newWidth, newHeight };
 }
 
-void Message::refreshInfoSkipBlock() {
+bool Message::hasTextSkipBlock() const {
 	const auto item = data();
 	const auto media = this->media();
-	const auto hasTextSkipBlock = [&] {
-		if (item->_text.empty()) {
-			if (const auto media = data()->media()) {
-				return media->storyExpired();
-			}
-			return false;
-		} else if (item->Has<HistoryMessageLogEntryOriginal>()) {
-			return false;
-		} else if (media && media->isDisplayed() && !_invertMedia) {
-			return false;
-		} else if (_reactions) {
-			return false;
+	if (item->_text.empty()) {
+		if (const auto media = item->media()) {
+			return media->storyExpired();
 		}
-		return true;
-	}();
+		return false;
+	} else if (item->Has<HistoryMessageLogEntryOriginal>()) {
+		return false;
+	} else if (media && media->isDisplayed() && !_invertMedia) {
+		return false;
+	} else if (_reactions) {
+		return false;
+	}
+	return true;
+}
+
+void Message::refreshInfoSkipBlock() {
 	const auto skipWidth = skipBlockWidth();
 	const auto skipHeight = skipBlockHeight();
 	if (_reactions) {
@@ -4084,7 +4092,7 @@ void Message::refreshInfoSkipBlock() {
 			_reactions->removeSkipBlock();
 		}
 	}
-	validateTextSkipBlock(hasTextSkipBlock, skipWidth, skipHeight);
+	validateTextSkipBlock(hasTextSkipBlock(), skipWidth, skipHeight);
 }
 
 TimeId Message::displayedEditDate() const {
@@ -164,6 +164,7 @@ public:
 
 protected:
 	void refreshDataIdHook() override;
+	void textWarmedUpHook() const override;
 
 private:
 	struct CommentsButton;
@@ -278,6 +279,7 @@ private:
 
 	void ensureRightAction() const;
 	void refreshTopicButton();
+	[[nodiscard]] bool hasTextSkipBlock() const;
 	void refreshInfoSkipBlock();
 	[[nodiscard]] int plainMaxWidth() const;
 	[[nodiscard]] int monospaceMaxWidth() const;
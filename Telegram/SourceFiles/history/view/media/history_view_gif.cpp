@@ -840,10 +840,12 @@ void Gif::validateThumbCache(
 			&& (normal->width() < kUseNonBlurredThreshold)
 			&& (normal->height() < kUseNonBlurredThreshold))
 		: !videothumb;
+	const auto withInline = !blurred || _dataMedia->thumbnailInlineAsync();
 	const auto ratio = style::DevicePixelRatio();
 	if (_thumbCache.size() == (outer * ratio)
 		&& _thumbCacheRounding == rounding
 		&& _thumbCacheBlurred == blurred
+		&& _thumbCacheInline == withInline
 		&& _thumbIsEllipse == isEllipse) {
 		return;
 	}
@@ -853,6 +855,7 @@ void Gif::validateThumbCache(
 		: Images::Round(std::move(cache), MediaRoundingMask(rounding));
 	_thumbCacheRounding = rounding;
 	_thumbCacheBlurred = blurred;
+	_thumbCacheInline = withInline;
 }
 
 QImage Gif::prepareThumbCache(QSize outer) const {
@@ -868,7 +871,7 @@ QImage Gif::prepareThumbCache(QSize outer) const {
 	const auto blurFromLarge = good || (normal && !blurred);
 	const auto large = blurFromLarge ? normal : videothumb;
 	if (videothumb) {
-	} else if (const auto embedded = _dataMedia->thumbnailInline()) {
+	} else if (const auto embedded = _dataMedia->thumbnailInlineAsync()) {
 		blurred = embedded;
 	}
 	const auto resize = large
@@ -1612,6 +1615,17 @@ void Gif::validateGroupedCache(
 		Ui::BubbleRounding rounding,
 		not_null<uint64*> cacheKey,
 		not_null<QPixmap*> cache) const {
+	const auto request = groupedCacheRequest(geometry, rounding, *cacheKey);
+	if (const auto prepare = request.prepare) {
+		*cacheKey = request.key;
+		*cache = Ui::PixmapFromImage(prepare());
+	}
+}
+
+GroupedCacheRequest Gif::groupedCacheRequest(
+		const QRect &geometry,
+		Ui::BubbleRounding rounding,
+		uint64 currentKey) const {
 	using Option = Images::Option;
 
 	ensureDataMediaCreated();
@@ -1622,7 +1636,7 @@ void Gif::validateGroupedCache(
 		? good
 		: thumb
 		? thumb
-		: _dataMedia->thumbnailInline();
+		: _dataMedia->thumbnailInlineAsync();
 	const auto blur = !good
 		&& (!thumb
 			|| (thumb->width() < kUseNonBlurredThreshold
@@ -1637,8 +1651,8 @@ void Gif::validateGroupedCache(
 		| (uint64(options) << 16)
 		| (uint64(rounding.key()) << 8)
 		| (uint64(loadLevel));
-	if (*cacheKey == key) {
-		return;
+	if (currentKey == key) {
+		return { .key = key };
 	}
 
 	const auto original = sizeForAspectRatio();
@@ -1648,16 +1662,27 @@ void Gif::validateGroupedCache(
 		{ originalWidth, originalHeight },
 		{ width, height });
 	const auto ratio = style::DevicePixelRatio();
-
-	*cacheKey = key;
-	auto scaled = Images::Prepare(
-		(image ? image : Image::BlankMedia().get())->original(),
-		pixSize * ratio,
-		{ .options = options, .outer = { width, height } });
-	auto rounded = Images::Round(
-		std::move(scaled),
-		MediaRoundingMask(rounding));
-	*cache = Ui::PixmapFromImage(std::move(rounded));
+	const auto small = _dataMedia->thumbnailInlineAsync()
+		? _dataMedia->thumbnailInlineAsync()
+		: thumb;
+
+	return {
+		.key = key,
+		.prepare = PrepareGroupedCacheFn(
+			(image ? image : Image::BlankMedia().get())->original(),
+			pixSize * ratio,
+			{ width, height },
+			blur,
+			rounding),
+		.preview = (small
+			? PrepareGroupedCacheFn(
+				small->original(),
+				pixSize * ratio,
+				{ width, height },
+				true,
+				rounding)
+			: nullptr),
+	};
 }
 
 void Gif::setStatusSize(int64 newSize) const {
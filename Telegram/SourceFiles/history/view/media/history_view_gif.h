@@ -92,6 +92,10 @@ public:
 		float64 highlightOpacity,
 		not_null<uint64*> cacheKey,
 		not_null<QPixmap*> cache) const override;
+	GroupedCacheRequest groupedCacheRequest(
+		const QRect &geometry,
+		Ui::BubbleRounding rounding,
+		uint64 currentKey) const override;
 	TextState getStateGrouped(
 		const QRect &geometry,
 		RectParts sides,
@@ -228,6 +232,7 @@ private:
 	mutable QImage _roundingMask;
 	mutable std::optional<Ui::BubbleRounding> _thumbCacheRounding;
 	mutable bool _thumbCacheBlurred : 1 = false;
+	mutable bool _thumbCacheInline : 1 = false;
 	mutable bool _thumbIsEllipse : 1 = false;
 	mutable bool _pollingStory : 1 = false;
 
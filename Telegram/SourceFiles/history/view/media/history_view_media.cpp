@@ -427,4 +427,41 @@ Images::CornersMaskRef MediaRoundingMask(
 
 }
 
+QImage PrepareGroupedPlaceholder(QSize size, Ui::BubbleRounding rounding) {
+	auto result = QImage(size, QImage::Format_ARGB32_Premultiplied);
+	result.setDevicePixelRatio(style::DevicePixelRatio());
+	result.fill(st::imageBg->c);
+	return Images::Round(std::move(result), MediaRoundingMask(rounding));
+}
+
+Fn<QImage()> PrepareGroupedCacheFn(
+		QImage original,
+		QSize size,
+		QSize outer,
+		bool blur,
+		Ui::BubbleRounding rounding) {
+	// Copy the shared masks so that the main thread may rebuild them.
+	const auto mask = MediaRoundingMask(rounding);
+	auto masks = std::array<QImage, 4>();
+	for (auto i = 0; i != 4; ++i) {
+		if (mask.p[i]) {
+			masks[i] = *mask.p[i];
+		}
+	}
+	return [=] {
+		using Option = Images::Option;
+		auto ref = Images::CornersMaskRef();
+		for (auto i = 0; i != 4; ++i) {
+			if (!masks[i].isNull()) {
+				ref.p[i] = &masks[i];
+			}
+		}
+		auto scaled = Images::Prepare(
+			original,
+			size,
+			{ .options = (blur ? Option::Blur : Option()), .outer = outer });
+		return Images::Round(std::move(scaled), ref);
+	};
+}
+
 } // namespace HistoryView
@@ -60,6 +60,15 @@ enum class MediaInBubbleState : uchar {
 	Bottom,
 };
 
+struct GroupedCacheRequest {
+	uint64 key = 0;
+	Fn<QImage()> prepare; // Empty if the current cache is valid.
+
+	// Blurred from a small thumbnail, cheap enough to be prepared on the
+	// main thread and painted while prepare() runs. Empty if none exists.
+	Fn<QImage()> preview;
+};
+
 [[nodiscard]] TimeId DurationForTimestampLinks(
 	not_null<DocumentData*> document);
 [[nodiscard]] QString TimestampLinkBase(
@@ -209,6 +218,12 @@ public:
 			not_null<QPixmap*> cache) const {
 		Unexpected("Grouping method call.");
 	}
+	[[nodiscard]] virtual GroupedCacheRequest groupedCacheRequest(
+			const QRect &geometry,
+			Ui::BubbleRounding rounding,
+			uint64 currentKey) const {
+		return {};
+	}
 	[[nodiscard]] virtual TextState getStateGrouped(
 		const QRect &geometry,
 		RectParts sides,
@@ -376,4 +391,17 @@ protected:
 [[nodiscard]] Images::CornersMaskRef MediaRoundingMask(
 	std::optional<Ui::BubbleRounding> rounding);
 
+// Painted while the grouped cache is prepared if no thumbnail exists.
+[[nodiscard]] QImage PrepareGroupedPlaceholder(
+	QSize size,
+	Ui::BubbleRounding rounding);
+
+// The result may be called from any thread.
+[[nodiscard]] Fn<QImage()> PrepareGroupedCacheFn(
+	QImage original,
+	QSize size,
+	QSize outer,
+	bool blur,
+	Ui::BubbleRounding rounding);
+
 } // namespace HistoryView
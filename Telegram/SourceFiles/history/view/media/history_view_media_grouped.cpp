@@ -29,6 +29,40 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 namespace HistoryView {
 namespace {
 
+constexpr auto kGridLayoutCacheLimit = 256;
+
+[[nodiscard]] std::vector<Ui::GroupMediaLayout> LayoutGrid(
+		const std::vector<QSize> &sizes) {
+	// Albums are laid out again each time their views are recreated,
+	// while the same few size combinations repeat over a chat.
+	static auto cache = base::flat_map<
+		std::vector<int>,
+		std::vector<Ui::GroupMediaLayout>>();
+
+	const auto maxWidth = st::historyGroupWidthMax;
+	const auto minWidth = st::historyGroupWidthMin;
+	const auto spacing = st::historyGroupSkip;
+	auto key = std::vector<int>();
+	key.reserve(3 + sizes.size() * 2);
+	key.push_back(maxWidth);
+	key.push_back(minWidth);
+	key.push_back(spacing);
+	for (const auto &size : sizes) {
+		key.push_back(size.width());
+		key.push_back(size.height());
+	}
+	const auto i = cache.find(key);
+	if (i != end(cache)) {
+		return i->second;
+	}
+	auto result = Ui::LayoutMediaGroup(sizes, maxWidth, minWidth, spacing);
+	if (cache.size() >= kGridLayoutCacheLimit) {
+		cache.clear();
+	}
+	cache.emplace(std::move(key), result);
+	return result;
+}
+
 std::vector<Ui::GroupMediaLayout> LayoutPlaylist(
 		const std::vector<QSize> &sizes) {
 	Expects(!sizes.empty());
@@ -128,11 +162,7 @@ QSize GroupedMedia::countOptimalSize() {
 	}
 
 	const auto layout = (_mode == Mode::Grid)
-		? Ui::LayoutMediaGroup(
-			sizes,
-			st::historyGroupWidthMax,
-			st::historyGroupWidthMin,
-			st::historyGroupSkip)
+		? LayoutGrid(sizes)
 		: LayoutPlaylist(sizes);
 	Assert(layout.size() == _parts.size());
 
@@ -344,6 +374,9 @@ void GroupedMedia::draw(Painter &p, const PaintContext &context) const {
 		: adjustedBubbleRoundingWithCaption(_caption);
 	auto highlight = context.highlight.range;
 	const auto subpartHighlight = IsSubGroupSelection(highlight);
+	if (_mode == Mode::Grid) {
+		validatePartCaches(rounding);
+	}
 	for (auto i = 0, count = int(_parts.size()); i != count; ++i) {
 		const auto &part = _parts[i];
 		auto partContext = context.withSelection(fullSelection
@@ -370,6 +403,11 @@ void GroupedMedia::draw(Painter &p, const PaintContext &context) const {
 		if (!part.cache.isNull()) {
 			wasCache = true;
 		}
+
+		// While the cache is prepared in the background keep painting
+		// the previous one, a blurred preview or the placeholder instead
+		// of preparing it here synchronously.
+		auto pendingCacheKey = part.pendingCacheKey;
 		part.content->drawGrouped(
 			p,
 			partContext,
@@ -377,7 +415,7 @@ void GroupedMedia::draw(Painter &p, const PaintContext &context) const {
 			part.sides,
 			applyRoundingSides(rounding, part.sides),
 			highlightOpacity,
-			&part.cacheKey,
+			pendingCacheKey ? &pendingCacheKey : &part.cacheKey,
 			&part.cache);
 		if (!part.cache.isNull()) {
 			nowCache = true;
@@ -434,6 +472,65 @@ void GroupedMedia::draw(Painter &p, const PaintContext &context) const {
 	}
 }
 
+void GroupedMedia::validatePartCaches(Ui::BubbleRounding rounding) const {
+	const auto ratio = style::DevicePixelRatio();
+	for (auto i = 0, count = int(_parts.size()); i != count; ++i) {
+		const auto &part = _parts[i];
+		const auto partRounding = applyRoundingSides(rounding, part.sides);
+		auto request = part.content->groupedCacheRequest(
+			part.geometry,
+			partRounding,
+			part.cacheKey);
+		if (!request.prepare
+			|| !request.key
+			|| request.key == part.pendingCacheKey) {
+			continue;
+		}
+		const auto size = part.geometry.size() * ratio;
+		if (part.cache.isNull()) {
+			part.cacheKey = 0;
+			part.cache = Ui::PixmapFromImage(request.preview
+				? request.preview()
+				: PrepareGroupedPlaceholder(size, partRounding));
+		} else if (part.cache.size() != size) {
+			// Stretch the previous cache while resizing.
+			part.cacheKey = 0;
+			part.cache = part.cache.scaled(
+				size,
+				Qt::IgnoreAspectRatio,
+				Qt::FastTransformation);
+			part.cache.setDevicePixelRatio(ratio);
+		}
+		part.pendingCacheKey = request.key;
+		crl::async([
+			=,
+			weak = base::make_weak(this),
+			key = request.key,
+			prepare = std::move(request.prepare)
+		] {
+			auto image = prepare();
+			crl::on_main(weak, [=, image = std::move(image)]() mutable {
+				weak->applyPartCache(i, key, std::move(image));
+			});
+		});
+	}
+}
+
+void GroupedMedia::applyPartCache(
+		int index,
+		uint64 key,
+		QImage image) const {
+	if (index >= int(_parts.size()) || _parts[index].pendingCacheKey != key) {
+		return;
+	}
+	const auto &part = _parts[index];
+	part.pendingCacheKey = 0;
+	part.cacheKey = key;
+	part.cache = Ui::PixmapFromImage(std::move(image));
+	history()->owner().registerHeavyViewPart(_parent);
+	repaint();
+}
+
 TextState GroupedMedia::getPartState(
 		QPoint point,
 		StateRequest request) const {
@@ -839,6 +936,7 @@ void GroupedMedia::unloadHeavyPart() {
 	for (const auto &part : _parts) {
 		part.content->unloadHeavyPart();
 		part.cacheKey = 0;
+		part.pendingCacheKey = 0;
 		part.cache = QPixmap();
 	}
 	_caption.unloadPersistentAnimation();
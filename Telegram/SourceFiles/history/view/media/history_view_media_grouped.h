@@ -122,6 +122,7 @@ private:
 		QRect initialGeometry;
 		QRect geometry;
 		mutable uint64 cacheKey = 0;
+		mutable uint64 pendingCacheKey = 0;
 		mutable QPixmap cache;
 
 	};
@@ -145,6 +146,8 @@ private:
 		StateRequest request) const;
 
 	void refreshCaption();
+	void validatePartCaches(Ui::BubbleRounding rounding) const;
+	void applyPartCache(int index, uint64 key, QImage image) const;
 
 	[[nodiscard]] Ui::BubbleRounding applyRoundingSides(
 		Ui::BubbleRounding already,
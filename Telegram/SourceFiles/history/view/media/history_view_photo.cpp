@@ -467,9 +467,13 @@ void Photo::validateUserpicImageCache(QSize size, bool forum) const {
 	const auto large = _dataMedia->image(PhotoSize::Large);
 	const auto ratio = style::DevicePixelRatio();
 	const auto blurredValue = large ? 0 : 1;
+	const auto inlineValue = (large || _dataMedia->thumbnailInlineAsync())
+		? 1
+		: 0;
 	if (_imageCache.size() == (size * ratio)
 		&& _imageCacheForum == forumValue
-		&& _imageCacheBlurred == blurredValue) {
+		&& _imageCacheBlurred == blurredValue
+		&& _imageCacheInline == inlineValue) {
 		return;
 	}
 	auto original = [&] {
@@ -481,7 +485,7 @@ void Photo::validateUserpicImageCache(QSize size, bool forum) const {
 		} else if (const auto small = _dataMedia->image(
 				PhotoSize::Small)) {
 			return small->original();
-		} else if (const auto blurred = _dataMedia->thumbnailInline()) {
+		} else if (const auto blurred = _dataMedia->thumbnailInlineAsync()) {
 			return blurred->original();
 		} else {
 			return Image::Empty()->original();
@@ -503,6 +507,7 @@ void Photo::validateUserpicImageCache(QSize size, bool forum) const {
 	_imageCache = std::move(original);
 	_imageCacheForum = forumValue;
 	_imageCacheBlurred = blurredValue;
+	_imageCacheInline = inlineValue;
 }
 
 void Photo::validateImageCache(
@@ -511,9 +516,13 @@ void Photo::validateImageCache(
 	const auto large = _dataMedia->image(PhotoSize::Large);
 	const auto ratio = style::DevicePixelRatio();
 	const auto blurredValue = large ? 0 : 1;
+	const auto inlineValue = (large || _dataMedia->thumbnailInlineAsync())
+		? 1
+		: 0;
 	if (_imageCache.size() == (outer * ratio)
 		&& _imageCacheRounding == rounding
-		&& _imageCacheBlurred == blurredValue) {
+		&& _imageCacheBlurred == blurredValue
+		&& _imageCacheInline == inlineValue) {
 		return;
 	}
 	_imageCache = Images::Round(
@@ -521,6 +530,7 @@ void Photo::validateImageCache(
 		MediaRoundingMask(rounding));
 	_imageCacheRounding = rounding;
 	_imageCacheBlurred = blurredValue;
+	_imageCacheInline = inlineValue;
 }
 
 void Photo::validateSpoilerImageCache(
@@ -533,8 +543,13 @@ void Photo::validateSpoilerImageCache(
 		&& _spoiler->backgroundRounding == rounding) {
 		return;
 	}
+	// The spoiler background is not rebuilt when an inline thumbnail
+	// decoded in the background arrives, so decode it right away.
 	_spoiler->background = Images::Round(
-		prepareImageCacheWithLarge(outer, nullptr),
+		prepareImageCacheWithLarge(
+			outer,
+			nullptr,
+			_dataMedia->thumbnailInline()),
 		MediaRoundingMask(rounding));
 	_spoiler->backgroundRounding = rounding;
 }
@@ -542,13 +557,17 @@ void Photo::validateSpoilerImageCache(
 QImage Photo::prepareImageCache(QSize outer) const {
 	return prepareImageCacheWithLarge(
 		outer,
-		_dataMedia->image(PhotoSize::Large));
+		_dataMedia->image(PhotoSize::Large),
+		_dataMedia->thumbnailInlineAsync());
 }
 
-QImage Photo::prepareImageCacheWithLarge(QSize outer, Image *large) const {
+QImage Photo::prepareImageCacheWithLarge(
+		QSize outer,
+		Image *large,
+		Image *embedded) const {
 	using Size = PhotoSize;
 	auto blurred = (Image*)nullptr;
-	if (const auto embedded = _dataMedia->thumbnailInline()) {
+	if (embedded) {
 		blurred = embedded;
 	} else if (const auto thumbnail = _dataMedia->image(Size::Thumbnail)) {
 		blurred = thumbnail;
@@ -912,6 +931,17 @@ void Photo::validateGroupedCache(
 		Ui::BubbleRounding rounding,
 		not_null<uint64*> cacheKey,
 		not_null<QPixmap*> cache) const {
+	const auto request = groupedCacheRequest(geometry, rounding, *cacheKey);
+	if (const auto prepare = request.prepare) {
+		*cacheKey = request.key;
+		*cache = Ui::PixmapFromImage(prepare());
+	}
+}
+
+GroupedCacheRequest Photo::groupedCacheRequest(
+		const QRect &geometry,
+		Ui::BubbleRounding rounding,
+		uint64 currentKey) const {
 	using Option = Images::Option;
 
 	ensureDataMediaCreated();
@@ -919,7 +949,7 @@ void Photo::validateGroupedCache(
 	const auto loaded = _dataMedia->loaded();
 	const auto loadLevel = loaded
 		? 2
-		: (_dataMedia->thumbnailInline()
+		: (_dataMedia->thumbnailInlineAsync()
 			|| _dataMedia->image(PhotoSize::Small)
 			|| _dataMedia->image(PhotoSize::Thumbnail))
 		? 1
@@ -932,8 +962,8 @@ void Photo::validateGroupedCache(
 		| (uint64(options) << 16)
 		| (uint64(rounding.key()) << 8)
 		| (uint64(loadLevel));
-	if (*cacheKey == key) {
-		return;
+	if (currentKey == key) {
+		return { .key = key };
 	}
 
 	const auto unscaled = photoSize();
@@ -949,19 +979,32 @@ void Photo::validateGroupedCache(
 		? _dataMedia->image(PhotoSize::Thumbnail)
 		: _dataMedia->image(PhotoSize::Small)
 		? _dataMedia->image(PhotoSize::Small)
-		: _dataMedia->thumbnailInline()
-		? _dataMedia->thumbnailInline()
+		: _dataMedia->thumbnailInlineAsync()
+		? _dataMedia->thumbnailInlineAsync()
 		: Image::BlankMedia().get();
+	const auto small = _dataMedia->image(PhotoSize::Small)
+		? _dataMedia->image(PhotoSize::Small)
+		: _dataMedia->thumbnailInlineAsync()
+		? _dataMedia->thumbnailInlineAsync()
+		: _dataMedia->image(PhotoSize::Thumbnail);
 
-	*cacheKey = key;
-	auto scaled = Images::Prepare(
-		image->original(),
-		pixSize * ratio,
-		{ .options = options, .outer = { width, height } });
-	auto rounded = Images::Round(
-		std::move(scaled),
-		MediaRoundingMask(rounding));
-	*cache = Ui::PixmapFromImage(std::move(rounded));
+	return {
+		.key = key,
+		.prepare = PrepareGroupedCacheFn(
+			image->original(),
+			pixSize * ratio,
+			{ width, height },
+			!loaded,
+			rounding),
+		.preview = (small
+			? PrepareGroupedCacheFn(
+				small->original(),
+				pixSize * ratio,
+				{ width, height },
+				true,
+				rounding)
+			: nullptr),
+	};
 }
 
 bool Photo::createStreamingObjects() {
@@ -83,6 +83,10 @@ public:
 		float64 highlightOpacity,
 		not_null<uint64*> cacheKey,
 		not_null<QPixmap*> cache) const override;
+	GroupedCacheRequest groupedCacheRequest(
+		const QRect &geometry,
+		Ui::BubbleRounding rounding,
+		uint64 currentKey) const override;
 	TextState getStateGrouped(
 		const QRect &geometry,
 		RectParts sides,
@@ -147,7 +151,8 @@ private:
 		std::optional<Ui::BubbleRounding> rounding) const;
 	[[nodiscard]] QImage prepareImageCacheWithLarge(
 		QSize outer,
-		Image *large) const;
+		Image *large,
+		Image *embedded) const;
 
 	bool videoAutoplayEnabled() const;
 	void setStreamed(std::unique_ptr<Streamed> value);
@@ -175,9 +180,10 @@ private:
 	const std::unique_ptr<MediaSpoiler> _spoiler;
 	mutable QImage _imageCache;
 	mutable std::optional<Ui::BubbleRounding> _imageCacheRounding;
-	uint32 _serviceWidth : 28 = 0;
+	uint32 _serviceWidth : 27 = 0;
 	mutable uint32 _imageCacheForum : 1 = 0;
 	mutable uint32 _imageCacheBlurred : 1 = 0;
+	mutable uint32 _imageCacheInline : 1 = 0;
 	mutable uint32 _pollingStory : 1 = 0;
 	mutable uint32 _showEnlarge : 1 = 0;
 
@@ -267,6 +267,17 @@ void ListSection::paint(
 	}
 }
 
+void ListSection::preloadHeavyParts(int top, int bottom) const {
+	if (!_mosaic.empty()) {
+		return;
+	}
+	const auto fromIt = findItemAfterTop(top);
+	const auto tillIt = findItemAfterBottom(fromIt, bottom);
+	for (auto it = fromIt; it != tillIt; ++it) {
+		(*it)->preloadHeavyPart();
+	}
+}
+
 void ListSection::paintFloatingHeader(
 		Painter &p,
 		int visibleTop,
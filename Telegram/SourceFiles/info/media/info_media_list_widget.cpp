@@ -73,6 +73,14 @@ namespace {
 
 constexpr auto kMediaCountForSearch = 10;
 
+// Heavy parts (media views, thumbnails) of layouts farther than this
+// count of screens from the viewport are released.
+constexpr auto kHeavyLayoutsKeepScreens = 2;
+
+// Heavy parts of layouts closer than this count of screens to the
+// viewport are prepared before they become visible.
+constexpr auto kHeavyLayoutsPreloadScreens = 1;
+
 } // namespace
 
 struct ListWidget::DateBadge {
@@ -628,6 +636,7 @@ void ListWidget::visibleTopBottomUpdated(
 
 	checkMoveToOtherViewer();
 	clearHeavyItems();
+	preloadHeavyItems();
 
 	if (_dateBadge->goodType) {
 		updateDateBadgeFor(_visibleTop);
@@ -712,8 +721,10 @@ void ListWidget::clearHeavyItems() {
 		return;
 	}
 	_heavyLayoutsInvalidated = false;
-	const auto above = _visibleTop - visibleHeight;
-	const auto below = _visibleBottom + visibleHeight;
+	const auto above = _visibleTop
+		- kHeavyLayoutsKeepScreens * visibleHeight;
+	const auto below = _visibleBottom
+		+ kHeavyLayoutsKeepScreens * visibleHeight;
 	for (auto i = _heavyLayouts.begin(); i != _heavyLayouts.end();) {
 		const auto item = const_cast<BaseLayout*>(i->get());
 		const auto rect = findItemDetails(item).geometry;
@@ -732,6 +743,26 @@ void ListWidget::clearHeavyItems() {
 	}
 }
 
+void ListWidget::preloadHeavyItems() {
+	const auto visibleHeight = _visibleBottom - _visibleTop;
+	if (!visibleHeight) {
+		return;
+	}
+	const auto preload = [&](int from, int till) {
+		const auto fromSectionIt = findSectionAfterTop(from);
+		const auto tillSectionIt = findSectionAfterBottom(
+			fromSectionIt,
+			till);
+		for (auto it = fromSectionIt; it != tillSectionIt; ++it) {
+			const auto top = it->top();
+			it->preloadHeavyParts(from - top, till - top);
+		}
+	};
+	const auto distance = kHeavyLayoutsPreloadScreens * visibleHeight;
+	preload(_visibleBottom, _visibleBottom + distance);
+	preload(std::max(_visibleTop - distance, 0), _visibleTop);
+}
+
 ListScrollTopState ListWidget::countScrollState() const {
 	if (_sections.empty() || _visibleTop <= 0) {
 		return {};
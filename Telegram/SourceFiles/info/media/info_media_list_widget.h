@@ -265,6 +265,7 @@ private:
 	void validateTrippleClickStartTime();
 	void checkMoveToOtherViewer();
 	void clearHeavyItems();
+	void preloadHeavyItems();
 
 	void setActionBoxWeak(QPointer<Ui::BoxContent> box);
 
@@ -318,14 +318,21 @@ void Provider::markLayoutsStale() {
 }
 
 void Provider::clearStaleLayouts() {
+	auto removed = 0;
 	for (auto i = _layouts.begin(); i != _layouts.end();) {
 		if (i->second.stale) {
 			_layoutRemoved.fire(i->second.item.get());
 			i = _layouts.erase(i);
+			++removed;
 		} else {
 			++i;
 		}
 	}
+	if (removed) {
+		DEBUG_LOG(("Info Media: %1 stale layouts removed, %2 cached."
+			).arg(removed
+			).arg(_layouts.size()));
+	}
 }
 
 rpl::producer<not_null<BaseLayout*>> Provider::layoutRemoved() {
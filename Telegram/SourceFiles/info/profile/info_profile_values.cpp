@@ -12,6 +12,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "core/click_handler_types.h"
 #include "countries/countries_instance.h"
 #include "main/main_session.h"
+#include "storage/storage_account.h"
 #include "ui/wrap/slide_wrap.h"
 #include "tdb/tdb_format_phone.h" // Tdb::FormatPhone
 #include "ui/text/text_utilities.h"
@@ -85,6 +86,22 @@ void StripExternalLinks(TextWithEntities &text) {
 		text.entities.end());
 }
 
+[[nodiscard]] int StoredSharedMediaCount(
+		not_null<PeerData*> peer,
+		MsgId topicRootId,
+		PeerData *migrated,
+		Storage::SharedMediaType type) {
+	if (topicRootId) {
+		return 0;
+	}
+	auto &local = peer->session().local();
+	const auto count = local.sharedMediaCount(peer->id, type);
+	const auto migratedCount = migrated
+		? local.sharedMediaCount(migrated->id, type)
+		: std::make_optional(0);
+	return (count && migratedCount) ? (*count + *migratedCount) : 0;
+}
+
 } // namespace
 
 rpl::producer<QString> NameValue(not_null<PeerData*> peer) {
@@ -508,7 +525,9 @@ rpl::producer<int> SharedMediaCountValue(
 	) | rpl::map([](const SparseIdsMergedSlice &slice) {
 		return slice.fullCount();
 	}) | rpl::filter_optional();
-	return rpl::single(0) | rpl::then(std::move(updated));
+	return rpl::single(
+		StoredSharedMediaCount(peer, topicRootId, migrated, type)
+	) | rpl::then(std::move(updated));
 }
 
 rpl::producer<int> CommonGroupsCountValue(not_null<UserData*> user) {
@@ -9,6 +9,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 
 #include "base/platform/base_platform_info.h"
 #include "core/application.h"
+#include "core/core_tracing.h"
 #include "core/shortcuts.h"
 #include "storage/storage_account.h"
 #include "storage/storage_domain.h" // Storage::StartResult.
@@ -123,6 +124,7 @@ void Account::start(std::unique_ptr<MTP::Config> config) {
 }
 
 std::unique_ptr<Tdb::Account> Account::createTdb() {
+	const auto span = Core::TraceSpan("startup", "Main::Account::createTdb");
 	const auto key = domain().tdbKey();
 	const auto langpackPath = cWorkingDir() + u"tdata/lang"_q;
 	QDir().mkpath(langpackPath);
@@ -2058,6 +2058,10 @@ void MainWidget::dialogsToUp() {
 	}
 }
 
+bool MainWidget::dialogsBenchmarkPaint(Fn<void(QString)> done) {
+	return _dialogs && _dialogs->benchmarkPaint(std::move(done));
+}
+
 void MainWidget::checkActivation() {
 	_history->checkActivation();
 	if (_mainSection) {
@@ -145,6 +145,7 @@ public:
 	void windowShown();
 
 	void dialogsToUp();
+	bool dialogsBenchmarkPaint(Fn<void(QString)> done);
 	void checkActivation();
 
 	[[nodiscard]] PeerData *peer() const;
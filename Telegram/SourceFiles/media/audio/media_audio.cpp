@@ -35,7 +35,7 @@ namespace {
 
 constexpr auto kSuppressRatioAll = 0.2;
 constexpr auto kSuppressRatioSong = 0.05;
-constexpr auto kWaveformCounterBufferSize = 256 * 1024;
+constexpr auto kWaveformCounterPeaksCount = 1024;
 constexpr auto kEffectDestructionDelay = crl::time(1000);
 
 QMutex AudioMutex;
@@ -405,8 +405,7 @@ void Mixer::Track::clear() {
 	speed = 1.;
 
 	setExternalData(nullptr);
-	lastUpdateWhen = 0;
-	lastUpdatePosition = 0;
+	sync.publish(0, 0, 0);
 }
 
 void Mixer::Track::started() {
@@ -765,8 +764,7 @@ void Mixer::play(
 
 		current->clear(); // Clear all previous state.
 		current->state.id = audio;
-		current->lastUpdateWhen = 0;
-		current->lastUpdatePosition = 0;
+		current->sync.publish(audio.externalPlayId(), 0, 0);
 		current->setExternalData(std::move(externalData));
 		current->state.position = (positionMs * current->state.frequency)
 			/ 1000LL;
@@ -816,31 +814,41 @@ Streaming::TimePoint Mixer::getExternalSyncTimePoint(
 		const AudioMsgId &audio) const {
 	Expects(audio.externalPlayId() != 0);
 
-	auto result = Streaming::TimePoint();
-	const auto type = audio.type();
+	return externalSyncPoint(audio);
+}
 
-	QMutexLocker lock(&AudioMutex);
-	const auto track = trackForType(type);
-	if (track && track->state.id == audio && track->lastUpdateWhen > 0) {
-		result.trackTime = track->lastUpdatePosition;
-		result.worldTime = track->lastUpdateWhen;
+crl::time Mixer::getExternalCorrectedTime(const AudioMsgId &audio, crl::time frameMs, crl::time systemMs) {
+	auto result = frameMs;
+	if (const auto point = externalSyncPoint(audio)) {
+		result = point.trackTime;
+		if (systemMs > point.worldTime) {
+			result += (systemMs - point.worldTime);
+		}
 	}
 	return result;
 }
 
-crl::time Mixer::getExternalCorrectedTime(const AudioMsgId &audio, crl::time frameMs, crl::time systemMs) {
-	auto result = frameMs;
+Streaming::TimePoint Mixer::externalSyncPoint(
+		const AudioMsgId &audio) const {
+	const auto playId = audio.externalPlayId();
+	if (!playId) {
+		return Streaming::TimePoint();
+	}
+	// The current track index may change under AudioMutex, but the same
+	// external playback always stays in the same track of its type.
 	const auto type = audio.type();
-
-	QMutexLocker lock(&AudioMutex);
-	const auto track = trackForType(type);
-	if (track && track->state.id == audio && track->lastUpdateWhen > 0) {
-		result = static_cast<crl::time>(track->lastUpdatePosition);
-		if (systemMs > track->lastUpdateWhen) {
-			result += (systemMs - track->lastUpdateWhen);
+	const auto count = (type == AudioMsgId::Type::Video)
+		? 1
+		: kTogetherLimit;
+	for (auto index = 0; index != count; ++index) {
+		const auto track = trackForType(type, index);
+		if (!track) {
+			break;
+		} else if (const auto result = track->sync.read(playId)) {
+			return result;
 		}
 	}
-	return result;
+	return Streaming::TimePoint();
 }
 
 void Mixer::externalSoundProgress(const AudioMsgId &audio) {
@@ -851,13 +859,63 @@ void Mixer::externalSoundProgress(const AudioMsgId &audio) {
 	if (current && current->state.length && current->state.frequency) {
 		if (current->state.id == audio
 			&& current->state.state == State::Playing) {
-			current->lastUpdateWhen = crl::now();
-			current->lastUpdatePosition = (current->state.position * 1000LL)
-				/ current->state.frequency;
+			current->sync.publish(
+				audio.externalPlayId(),
+				crl::now(),
+				(current->state.position * 1000LL) / current->state.frequency);
 		}
 	}
 }
 
+void Mixer::SyncPoint::publish(
+		uint32 playId,
+		crl::time when,
+		crl::time position) {
+	// Single writer seqlock, the version is odd while fields are written.
+	const auto version = _version.load(std::memory_order_relaxed);
+	_version.store(version + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	_playId.store(playId, std::memory_order_relaxed);
+	_when.store(when, std::memory_order_relaxed);
+	_position.store(position, std::memory_order_relaxed);
+	_version.store(version + 2, std::memory_order_release);
+}
+
+Streaming::TimePoint Mixer::SyncPoint::read(uint32 playId) const {
+	auto result = Streaming::TimePoint();
+	while (true) {
+		const auto version = _version.load(std::memory_order_acquire);
+		if (version & 1) {
+			continue;
+		}
+		const auto id = _playId.load(std::memory_order_relaxed);
+		const auto when = _when.load(std::memory_order_relaxed);
+		const auto position = _position.load(std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (_version.load(std::memory_order_relaxed) != version) {
+			continue;
+		} else if (id == playId && when > 0) {
+			result.trackTime = position;
+			result.worldTime = when;
+		}
+		return result;
+	}
+}
+
+Mixer::Statistics Mixer::statistics() const {
+	return {
+		.underruns = _underruns.load(std::memory_order_relaxed),
+		.feedLatencyMax = _loader->feedLatencyMax(),
+	};
+}
+
+void Mixer::registerUnderrun(const AudioMsgId &audio) {
+	const auto underruns = ++_underruns;
+	DEBUG_LOG(("Audio Info: Underrun in playback %1, total underruns: %2."
+		).arg(audio.externalPlayId()
+		).arg(underruns));
+}
+
 bool Mixer::checkCurrentALError(AudioMsgId::Type type) {
 	if (!Audio::PlaybackErrorHappened()) return true;
 
@@ -910,8 +968,7 @@ void Mixer::pause(const AudioMsgId &audio, bool fast) {
 
 		scheduleFaderCallback();
 
-		track->lastUpdateWhen = 0;
-		track->lastUpdatePosition = 0;
+		track->sync.publish(audio.externalPlayId(), 0, 0);
 	}
 	if (current) updated(current);
 }
@@ -1327,6 +1384,9 @@ int32 Fader::updateOnePlayback(Mixer::Track *track, bool &hasPlaying, bool &hasF
 		track->updateStatePosition();
 		emitSignals |= EmitPositionUpdated;
 	} else if (track->state.waitingForData && !waitingForDataOld) {
+		if (playing && !track->loaded) {
+			mixer()->registerUnderrun(track->state.id);
+		}
 		if (withSpeedPosition > track->withSpeed.position) {
 			track->withSpeed.position = withSpeedPosition;
 		}
@@ -1582,30 +1642,20 @@ public:
 			return false;
 		}
 
-		QByteArray buffer;
-		buffer.reserve(kWaveformCounterBufferSize);
 		const auto samplesCount = samplesFrequency() * duration() / 1000;
 		int64 countbytes = sampleSize() * samplesCount;
 		int64 processed = 0;
-		int64 sumbytes = 0;
 		if (samplesCount < Media::Player::kWaveformSamplesCount) {
 			return false;
 		}
 
-		QVector<uint16> peaks;
-		peaks.reserve(Media::Player::kWaveformSamplesCount);
-
-		auto fmt = format();
-		auto peak = uint16(0);
-		auto callback = [&](uint16 sample) {
-			accumulate_max(peak, sample);
-			sumbytes += Media::Player::kWaveformSamplesCount;
-			if (sumbytes >= countbytes) {
-				sumbytes -= countbytes;
-				peaks.push_back(peak);
-				peak = 0;
-			}
-		};
+		const auto fmt = format();
+		const auto wide = (fmt == AL_FORMAT_MONO16)
+			|| (fmt == AL_FORMAT_STEREO16);
+		const auto valuesCount = countbytes / (wide ? 2 : 1);
+		auto builder = Audio::WaveformBuilder(std::max(
+			valuesCount / kWaveformCounterPeaksCount,
+			int64(1)));
 		while (processed < countbytes) {
 			const auto result = readMore();
 			Assert(result != ReadError::Wait); // Not a child loader.
@@ -1619,29 +1669,18 @@ public:
 			const auto sampleBytes = v::get<bytes::const_span>(result);
 			Assert(!sampleBytes.empty());
 			if (fmt == AL_FORMAT_MONO8 || fmt == AL_FORMAT_STEREO8) {
-				Media::Audio::IterateSamples<uchar>(sampleBytes, callback);
-			} else if (fmt == AL_FORMAT_MONO16 || fmt == AL_FORMAT_STEREO16) {
-				Media::Audio::IterateSamples<int16>(sampleBytes, callback);
+				builder.add(
+					reinterpret_cast<const uchar*>(sampleBytes.data()),
+					sampleBytes.size());
+			} else if (wide) {
+				builder.add(
+					reinterpret_cast<const int16*>(sampleBytes.data()),
+					sampleBytes.size() / sizeof(int16));
 			}
 			processed += sampleBytes.size();
 		}
-		if (sumbytes > 0 && peaks.size() < Media::Player::kWaveformSamplesCount) {
-			peaks.push_back(peak);
-		}
-
-		if (peaks.isEmpty()) {
-			return false;
-		}
-
-		auto sum = std::accumulate(peaks.cbegin(), peaks.cend(), 0LL);
-		peak = qMax(int32(sum * 1.8 / peaks.size()), 2500);
-
-		result.resize(peaks.size());
-		for (int32 i = 0, l = peaks.size(); i != l; ++i) {
-			result[i] = char(qMin(31U, uint32(qMin(peaks.at(i), peak)) * 31 / peak));
-		}
-
-		return true;
+		result = builder.finish();
+		return !result.isEmpty();
 	}
 
 	const VoiceWaveform &waveform() const {
@@ -1668,3 +1707,103 @@ VoiceWaveform audioCountWaveform(
 	}
 	return VoiceWaveform();
 }
+
+namespace Media::Audio {
+
+uint16 BlockPeak(const uchar *samples, int64 count) {
+	auto min = uchar(0x80);
+	auto max = uchar(0x80);
+	for (auto i = int64(); i != count; ++i) {
+		min = std::min(min, samples[i]);
+		max = std::max(max, samples[i]);
+	}
+	return std::max(ReadOneSample(min), ReadOneSample(max));
+}
+
+uint16 BlockPeak(const int16 *samples, int64 count) {
+	auto result = uint16(0);
+	for (auto i = int64(); i != count; ++i) {
+		const auto value = int32(samples[i]);
+		result = std::max(result, uint16(value < 0 ? -value : value));
+	}
+	return result;
+}
+
+WaveformBuilder::WaveformBuilder(int64 samplesPerPeak)
+: _samplesPerPeak(samplesPerPeak) {
+	Expects(_samplesPerPeak > 0);
+}
+
+void WaveformBuilder::add(const uchar *samples, int64 count) {
+	addSamples(samples, count);
+}
+
+void WaveformBuilder::add(const int16 *samples, int64 count) {
+	addSamples(samples, count);
+}
+
+template <typename SampleType>
+void WaveformBuilder::addSamples(const SampleType *samples, int64 count) {
+	while (count > 0) {
+		const auto take = std::min(count, _samplesPerPeak - _blockSamples);
+		_blockPeak = std::max(_blockPeak, BlockPeak(samples, take));
+		_blockSamples += take;
+		samples += take;
+		count -= take;
+		if (_blockSamples == _samplesPerPeak) {
+			_peaks.push_back(_blockPeak);
+			_blockSamples = 0;
+			_blockPeak = 0;
+		}
+	}
+}
+
+void WaveformBuilder::clear() {
+	_blockSamples = 0;
+	_blockPeak = 0;
+	_peaks.clear();
+}
+
+bool WaveformBuilder::empty() const {
+	return _peaks.empty() && !_blockSamples;
+}
+
+VoiceWaveform WaveformBuilder::finish() const {
+	const auto count = int64(_peaks.size()) + (_blockSamples ? 1 : 0);
+	if (count < Player::kWaveformSamplesCount) {
+		return VoiceWaveform();
+	}
+	auto peaks = std::vector<uint16>();
+	peaks.reserve(Player::kWaveformSamplesCount);
+
+	auto peak = uint16(0);
+	auto sum = int64(0);
+	const auto add = [&](uint16 sample) {
+		accumulate_max(peak, sample);
+		sum += Player::kWaveformSamplesCount;
+		if (sum >= count) {
+			sum -= count;
+			peaks.push_back(peak);
+			peak = 0;
+		}
+	};
+	for (const auto sample : _peaks) {
+		add(sample);
+	}
+	if (_blockSamples) {
+		add(_blockPeak);
+	}
+
+	const auto total = std::accumulate(begin(peaks), end(peaks), 0LL);
+	const auto limit = std::max(int32(total * 1.8 / peaks.size()), 2500);
+
+	auto result = VoiceWaveform(peaks.size());
+	for (auto i = 0, l = int(peaks.size()); i != l; ++i) {
+		result[i] = char(std::min(
+			31U,
+			uint32(std::min(int32(peaks[i]), limit)) * 31 / limit));
+	}
+	return result;
+}
+
+} // namespace Media::Audio
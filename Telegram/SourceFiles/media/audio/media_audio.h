@@ -15,6 +15,8 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 
 #include <QtCore/QTimer>
 
+#include <atomic>
+
 namespace Ui {
 struct PreparedFileInformation;
 } // namespace Ui
@@ -154,8 +156,10 @@ public:
 	// Thread: Main. Locks: AudioMutex.
 	void setSpeedFromExternal(const AudioMsgId &audioId, float64 speed);
 
+	// Thread: Any.
 	Streaming::TimePoint getExternalSyncTimePoint(
 		const AudioMsgId &audio) const;
+	// Thread: Any.
 	crl::time getExternalCorrectedTime(
 		const AudioMsgId &id,
 		crl::time frameMs,
@@ -174,6 +178,14 @@ public:
 	// Thread: Any. Must be locked: AudioMutex.
 	void reattachTracks();
 
+	struct Statistics {
+		int underruns = 0;
+		crl::time feedLatencyMax = 0;
+	};
+
+	// Thread: Any.
+	[[nodiscard]] Statistics statistics() const;
+
 	// Thread: Any.
 	void setSongVolume(float64 volume);
 	float64 getSongVolume() const;
@@ -201,6 +213,24 @@ Q_SIGNALS:
 	void suppressAll(qint64 duration);
 
 private:
+	// Playback position of an external sound, published by the mixer
+	// and read by the streaming threads without locking AudioMutex.
+	class SyncPoint final {
+	public:
+		// Thread: Any. Must be locked: AudioMutex.
+		void publish(uint32 playId, crl::time when, crl::time position);
+
+		// Thread: Any.
+		[[nodiscard]] Streaming::TimePoint read(uint32 playId) const;
+
+	private:
+		std::atomic<uint32> _version = 0;
+		std::atomic<uint32> _playId = 0;
+		std::atomic<crl::time> _when = 0;
+		std::atomic<crl::time> _position = 0;
+
+	};
+
 	class Track {
 	public:
 		static constexpr int kBuffersCount = 3;
@@ -267,8 +297,7 @@ private:
 
 		std::unique_ptr<ExternalSoundData> externalData;
 
-		crl::time lastUpdateWhen = 0;
-		crl::time lastUpdatePosition = 0;
+		SyncPoint sync;
 
 	private:
 		void createStream(AudioMsgId::Type type);
@@ -282,6 +311,11 @@ private:
 	bool checkCurrentALError(AudioMsgId::Type type);
 
 	void externalSoundProgress(const AudioMsgId &audio);
+	[[nodiscard]] Streaming::TimePoint externalSyncPoint(
+		const AudioMsgId &audio) const;
+
+	// Thread: Any.
+	void registerUnderrun(const AudioMsgId &audio);
 
 	// Thread: Any. Must be locked: AudioMutex.
 	void setStoppedState(Track *current, State state = State::Stopped);
@@ -304,6 +338,8 @@ private:
 	QAtomicInt _volumeVideo;
 	QAtomicInt _volumeSong;
 
+	std::atomic<int> _underruns = 0;
+
 	friend class Fader;
 	friend class Loaders;
 
@@ -413,5 +449,34 @@ void IterateSamples(bytes::const_span bytes, Callback &&callback) {
 	}
 }
 
+// Same as the maximum of ReadOneSample() over the block, but written
+// without branches in the loop body, so that it gets auto-vectorized.
+[[nodiscard]] uint16 BlockPeak(const uchar *samples, int64 count);
+[[nodiscard]] uint16 BlockPeak(const int16 *samples, int64 count);
+
+// Collects peaks of fixed-size sample blocks while the audio is decoded
+// or captured, so that the waveform is ready right when it ends.
+class WaveformBuilder final {
+public:
+	explicit WaveformBuilder(int64 samplesPerPeak);
+
+	void add(const uchar *samples, int64 count);
+	void add(const int16 *samples, int64 count);
+	void clear();
+
+	[[nodiscard]] bool empty() const;
+	[[nodiscard]] VoiceWaveform finish() const;
+
+private:
+	template <typename SampleType>
+	void addSamples(const SampleType *samples, int64 count);
+
+	int64 _samplesPerPeak = 0;
+	int64 _blockSamples = 0;
+	uint16 _blockPeak = 0;
+	std::vector<uint16> _peaks;
+
+};
+
 } // namespace Audio
 } // namespace Media
@@ -14,8 +14,6 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include <al.h>
 #include <alc.h>
 
-#include <numeric>
-
 namespace Media {
 namespace Capture {
 namespace {
@@ -172,10 +170,7 @@ struct Instance::Inner::Private {
 	QByteArray data;
 	int32 dataPos = 0;
 
-	int64 waveformMod = 0;
-	int64 waveformEach = (kCaptureFrequency / 100);
-	uint16 waveformPeak = 0;
-	QVector<uchar> waveform;
+	Audio::WaveformBuilder waveform{ kCaptureFrequency / 100 };
 
 	static int ReadData(void *opaque, uint8_t *buf, int buf_size) {
 		auto l = reinterpret_cast<Private*>(opaque);
@@ -431,8 +426,6 @@ void Instance::Inner::stop(Fn<void(Result&&)> callback) {
 			d->fullSamples = 0;
 			d->dataPos = 0;
 			d->data.clear();
-			d->waveformMod = 0;
-			d->waveformPeak = 0;
 			d->waveform.clear();
 		} else {
 			float64 coef = 1. / fadeSamples, fadedFrom = 0;
@@ -458,8 +451,6 @@ void Instance::Inner::stop(Fn<void(Result&&)> callback) {
 				d->fullSamples = 0;
 				d->dataPos = 0;
 				d->data.clear();
-				d->waveformMod = 0;
-				d->waveformPeak = 0;
 				d->waveform.clear();
 			}
 		}
@@ -479,34 +470,8 @@ void Instance::Inner::stop(Fn<void(Result&&)> callback) {
 	QByteArray result = d->fullSamples ? d->data : QByteArray();
 	VoiceWaveform waveform;
 	qint32 samples = d->fullSamples;
-	if (needResult && samples && !d->waveform.isEmpty()) {
-		int64 count = d->waveform.size(), sum = 0;
-		if (count >= Player::kWaveformSamplesCount) {
-			QVector<uint16> peaks;
-			peaks.reserve(Player::kWaveformSamplesCount);
-
-			uint16 peak = 0;
-			for (int32 i = 0; i < count; ++i) {
-				uint16 sample = uint16(d->waveform.at(i)) * 256;
-				if (peak < sample) {
-					peak = sample;
-				}
-				sum += Player::kWaveformSamplesCount;
-				if (sum >= count) {
-					sum -= count;
-					peaks.push_back(peak);
-					peak = 0;
-				}
-			}
-
-			auto sum = std::accumulate(peaks.cbegin(), peaks.cend(), 0LL);
-			peak = qMax(int32(sum * 1.8 / peaks.size()), 2500);
-
-			waveform.resize(peaks.size());
-			for (int32 i = 0, l = peaks.size(); i != l; ++i) {
-				waveform[i] = char(qMin(31U, uint32(qMin(peaks.at(i), peak)) * 31 / peak));
-			}
-		}
+	if (needResult && samples) {
+		waveform = d->waveform.finish();
 	}
 	if (hadDevice) {
 		if (d->codecContext) {
@@ -555,8 +520,6 @@ void Instance::Inner::stop(Fn<void(Result&&)> callback) {
 		d->dataPos = 0;
 		d->data.clear();
 
-		d->waveformMod = 0;
-		d->waveformPeak = 0;
 		d->waveform.clear();
 	}
 
@@ -667,18 +630,7 @@ bool Instance::Inner::processFrame(int32 offset, int32 framesize) {
 		}
 	}
 
-	d->waveform.reserve(d->waveform.size() + (samplesCnt / d->waveformEach) + 1);
-	for (short *ptr = srcSamplesDataChannel, *end = ptr + samplesCnt; ptr != end; ++ptr) {
-		uint16 value = qAbs(*ptr);
-		if (d->waveformPeak < value) {
-			d->waveformPeak = value;
-		}
-		if (++d->waveformMod == d->waveformEach) {
-			d->waveformMod -= d->waveformEach;
-			d->waveform.push_back(uchar(d->waveformPeak / 256));
-			d->waveformPeak = 0;
-		}
-	}
+	d->waveform.add(srcSamplesDataChannel, samplesCnt);
 
 	// Convert to final format
 
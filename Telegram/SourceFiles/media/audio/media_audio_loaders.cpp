@@ -24,42 +24,74 @@ Loaders::Loaders(QThread *thread)
 }
 
 void Loaders::feedFromExternal(ExternalSoundPart &&part) {
-	auto invoke = false;
-	{
-		QMutexLocker lock(&_fromExternalMutex);
-		invoke = _fromExternalQueues.empty()
-			&& _fromExternalForceToBuffer.empty();
-		auto &queue = _fromExternalQueues[part.audio];
-		queue.insert(
-			end(queue),
-			std::make_move_iterator(part.packets.begin()),
-			std::make_move_iterator(part.packets.end()));
-	}
-	if (invoke) {
-		_fromExternalNotify.call();
-	}
+	auto request = std::make_unique<FromExternal>();
+	request->audio = part.audio;
+	request->packets.insert(
+		end(request->packets),
+		std::make_move_iterator(part.packets.begin()),
+		std::make_move_iterator(part.packets.end()));
+	pushFromExternal(std::move(request));
 }
 
 void Loaders::forceToBufferExternal(const AudioMsgId &audioId) {
-	auto invoke = false;
-	{
-		QMutexLocker lock(&_fromExternalMutex);
-		invoke = _fromExternalQueues.empty()
-			&& _fromExternalForceToBuffer.empty();
-		_fromExternalForceToBuffer.emplace(audioId);
+	auto request = std::make_unique<FromExternal>();
+	request->audio = audioId;
+	request->forceToBuffer = true;
+	pushFromExternal(std::move(request));
+}
+
+void Loaders::pushFromExternal(std::unique_ptr<FromExternal> request) {
+	request->queued = crl::now();
+	const auto raw = request.release();
+	raw->next = _fromExternal.load(std::memory_order_relaxed);
+	while (!_fromExternal.compare_exchange_weak(
+		raw->next,
+		raw,
+		std::memory_order_release,
+		std::memory_order_relaxed)) {
 	}
-	if (invoke) {
+
+	// Only the first request after the stack was taken notifies.
+	if (!raw->next) {
 		_fromExternalNotify.call();
 	}
 }
 
+auto Loaders::takeFromExternal()
+-> std::vector<std::unique_ptr<FromExternal>> {
+	auto result = std::vector<std::unique_ptr<FromExternal>>();
+	auto head = _fromExternal.exchange(nullptr, std::memory_order_acquire);
+	while (head) {
+		result.emplace_back(head);
+		head = base::take(head->next);
+	}
+	ranges::reverse(result);
+	return result;
+}
+
+crl::time Loaders::feedLatencyMax() const {
+	return _fromExternalLatencyMax.load(std::memory_order_relaxed);
+}
+
 void Loaders::videoSoundAdded() {
-	auto queues = decltype(_fromExternalQueues)();
-	auto forces = decltype(_fromExternalForceToBuffer)();
-	{
-		QMutexLocker lock(&_fromExternalMutex);
-		queues = base::take(_fromExternalQueues);
-		forces = base::take(_fromExternalForceToBuffer);
+	auto queues = base::flat_map<AudioMsgId, std::deque<FFmpeg::Packet>>();
+	auto forces = base::flat_set<AudioMsgId>();
+	const auto now = crl::now();
+	auto latency = crl::time(0);
+	for (auto &request : takeFromExternal()) {
+		accumulate_max(latency, now - request->queued);
+		if (request->forceToBuffer) {
+			forces.emplace(request->audio);
+		} else {
+			auto &queue = queues[request->audio];
+			queue.insert(
+				end(queue),
+				std::make_move_iterator(request->packets.begin()),
+				std::make_move_iterator(request->packets.end()));
+		}
+	}
+	if (_fromExternalLatencyMax.load(std::memory_order_relaxed) < latency) {
+		_fromExternalLatencyMax.store(latency, std::memory_order_relaxed);
 	}
 	for (const auto &audioId : forces) {
 		const auto tryLoader = [&](const auto &id, auto &loader) {
@@ -581,7 +613,9 @@ void Loaders::onCancel(const AudioMsgId &audio) {
 	}
 }
 
-Loaders::~Loaders() = default;
+Loaders::~Loaders() {
+	takeFromExternal();
+}
 
 } // namespace Player
 } // namespace Media
@@ -23,6 +23,10 @@ public:
 	Loaders(QThread *thread);
 	void feedFromExternal(ExternalSoundPart &&part);
 	void forceToBufferExternal(const AudioMsgId &audioId);
+
+	// Thread: Any.
+	[[nodiscard]] crl::time feedLatencyMax() const;
+
 	~Loaders();
 
 Q_SIGNALS:
@@ -37,6 +41,16 @@ public Q_SLOTS:
 	void onCancel(const AudioMsgId &audio);
 
 private:
+	// Packets and buffering requests from the streaming threads, pushed
+	// to a lock-free stack and taken by the loader thread all at once.
+	struct FromExternal {
+		AudioMsgId audio;
+		std::deque<FFmpeg::Packet> packets;
+		crl::time queued = 0;
+		bool forceToBuffer = false;
+		FromExternal *next = nullptr;
+	};
+
 	struct SetupLoaderResult {
 		AudioPlayerLoader *loader = nullptr;
 		float64 oldSpeed = 0.;
@@ -49,6 +63,8 @@ private:
 		bool justStarted = false;
 	};
 
+	void pushFromExternal(std::unique_ptr<FromExternal> request);
+	[[nodiscard]] std::vector<std::unique_ptr<FromExternal>> takeFromExternal();
 	void videoSoundAdded();
 	[[nodiscard]] Mixer::Track::WithSpeed rebufferOnSpeedChange(
 		const SetupLoaderResult &setup);
@@ -68,11 +84,8 @@ private:
 	std::unique_ptr<AudioPlayerLoader> _songLoader;
 	std::unique_ptr<AudioPlayerLoader> _videoLoader;
 
-	QMutex _fromExternalMutex;
-	base::flat_map<
-		AudioMsgId,
-		std::deque<FFmpeg::Packet>> _fromExternalQueues;
-	base::flat_set<AudioMsgId> _fromExternalForceToBuffer;
+	std::atomic<FromExternal*> _fromExternal = nullptr;
+	std::atomic<crl::time> _fromExternalLatencyMax = 0;
 	SingleQueuedInvokation _fromExternalNotify;
 
 };
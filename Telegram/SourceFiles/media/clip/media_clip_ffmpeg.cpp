@@ -55,6 +55,9 @@ FFMpegReaderImplementation::FFMpegReaderImplementation(
 }
 
 ReaderImplementation::ReadResult FFMpegReaderImplementation::readNextFrame() {
+	if (_cached) {
+		return readCachedFrame();
+	}
 	do {
 		int res = avcodec_receive_frame(_codecContext, _frame.get());
 		if (res >= 0) {
@@ -73,6 +76,8 @@ ReaderImplementation::ReadResult FFMpegReaderImplementation::readNextFrame() {
 			if (!_hadFrame) {
 				LOG(("Gif Error: Got EOF before a single frame was read!"));
 				return ReadResult::Error;
+			} else if (finishRecording()) {
+				return readCachedFrame();
 			}
 
 			if ((res = avformat_seek_file(_fmtContext, _streamId, std::numeric_limits<int64_t>::min(), 0, std::numeric_limits<int64_t>::max(), 0)) < 0) {
@@ -143,10 +148,34 @@ ReaderImplementation::ReadResult FFMpegReaderImplementation::readNextFrame() {
 	return ReadResult::Error;
 }
 
+ReaderImplementation::ReadResult FFMpegReaderImplementation::readCachedFrame() {
+	Expects(_cached != nullptr);
+
+	if (_frameIndex + 1 >= int(_cached->size())) {
+		_frameMs = 0;
+		_frameIndex = -1;
+	}
+	const auto &frame = (*_cached)[_frameIndex + 1];
+	processFrameTiming(frame.position, frame.duration);
+	return ReadResult::Success;
+}
+
 void FFMpegReaderImplementation::processReadFrame() {
 	int64 duration = _frame->pkt_duration;
 	int64 framePts = _frame->pts;
 	crl::time frameMs = (framePts * 1000LL * _fmtContext->streams[_streamId]->time_base.num) / _fmtContext->streams[_streamId]->time_base.den;
+	const auto nextFrameDelay = (duration == AV_NOPTS_VALUE)
+		? 0
+		: int((duration * 1000LL * _fmtContext->streams[_streamId]->time_base.num) / _fmtContext->streams[_streamId]->time_base.den);
+	processFrameTiming(frameMs, nextFrameDelay);
+}
+
+void FFMpegReaderImplementation::processFrameTiming(
+		crl::time frameMs,
+		int nextFrameDelay) {
+	_framePosition = frameMs;
+	_frameDuration = nextFrameDelay;
+
 	_currentFrameDelay = _nextFrameDelay;
 	if (_frameMs + _currentFrameDelay < frameMs) {
 		_currentFrameDelay = int32(frameMs - _frameMs);
@@ -154,11 +183,7 @@ void FFMpegReaderImplementation::processReadFrame() {
 		frameMs = _frameMs + _currentFrameDelay;
 	}
 
-	if (duration == AV_NOPTS_VALUE) {
-		_nextFrameDelay = 0;
-	} else {
-		_nextFrameDelay = (duration * 1000LL * _fmtContext->streams[_streamId]->time_base.num) / _fmtContext->streams[_streamId]->time_base.den;
-	}
+	_nextFrameDelay = nextFrameDelay;
 	_frameMs = frameMs;
 
 	_hadFrame = _frameRead = true;
@@ -223,6 +248,12 @@ bool FFMpegReaderImplementation::renderFrame(
 	if (!size.isEmpty() && rotationSwapWidthHeight()) {
 		toSize.transpose();
 	}
+	if (cacheFrames()) {
+		validateCacheKey(toSize);
+		if (_cached) {
+			return renderCachedFrame(to, hasAlpha, toSize);
+		}
+	}
 	if (to.isNull() || to.size() != toSize || !to.isDetached() || !isAlignedImage(to)) {
 		to = createAlignedImage(toSize);
 	}
@@ -259,12 +290,103 @@ bool FFMpegReaderImplementation::renderFrame(
 		}
 		to = to.transformed(rotationTransform);
 	}
+	if (_cacheKey) {
+		recordFrame(to, index, hasAlpha);
+	}
 
 	FFmpeg::ClearFrameMemory(_frame.get());
 
 	return true;
 }
 
+bool FFMpegReaderImplementation::cacheFrames() const {
+	return (_mode == Mode::Silent)
+		&& (_rotation == Rotation::None)
+		&& !_data->isEmpty()
+		&& isWebmSticker();
+}
+
+void FFMpegReaderImplementation::validateCacheKey(QSize size) {
+	if (!_cacheKey
+		|| _cacheKey.width != size.width()
+		|| _cacheKey.height != size.height()) {
+		_cacheKey = ComputeFramesCacheKey(*_data, size);
+		_recording.clear();
+
+		// Frames are recorded only from the first one of the loop.
+		_recordingFailed = (_frameIndex != 0);
+	}
+	if (_cached && _cachedKey == _cacheKey) {
+		return;
+	}
+	auto found = FindCachedFrames(_cacheKey);
+	if (found && _frameIndex < int(found->size())) {
+		// Some other reader has already decoded this sticker, stop decoding.
+		_cached = std::move(found);
+		_cachedKey = _cacheKey;
+		_recording.clear();
+		FFmpeg::ClearFrameMemory(_frame.get());
+	}
+}
+
+bool FFMpegReaderImplementation::renderCachedFrame(
+		QImage &to,
+		bool &hasAlpha,
+		QSize size) {
+	Expects(_frameIndex >= 0 && _frameIndex < int(_cached->size()));
+
+	const auto cachedSize = QSize(_cachedKey.width, _cachedKey.height);
+	if (to.isNull() || to.size() != cachedSize || !to.isDetached() || !isAlignedImage(to)) {
+		to = createAlignedImage(cachedSize);
+	}
+	const auto &frame = (*_cached)[_frameIndex];
+	if (!DecompressFrame(frame, to)) {
+		LOG(("Gif Error: Bad cached frame %1").arg(logData()));
+		return false;
+	}
+	hasAlpha = frame.alpha;
+	if (size != cachedSize) {
+		// Decoding can't be resumed once the frames come from the cache,
+		// so the frames are scaled if the requested size has changed.
+		to = to.scaled(
+			size,
+			Qt::IgnoreAspectRatio,
+			Qt::SmoothTransformation);
+	}
+	return true;
+}
+
+void FFMpegReaderImplementation::recordFrame(
+		const QImage &frame,
+		int index,
+		bool alpha) {
+	if (_recordingFailed) {
+		return;
+	} else if (index != int(_recording.size())) {
+		// Some frame was skipped while catching up, try the next loop.
+		_recordingFailed = true;
+		_recording.clear();
+		return;
+	}
+	_recording.push_back(
+		CompressFrame(frame, _framePosition, _frameDuration, alpha));
+}
+
+bool FFMpegReaderImplementation::finishRecording() {
+	if (!_cacheKey) {
+		return false;
+	} else if (_recordingFailed
+		|| _recording.empty()
+		|| int(_recording.size()) != _frameIndex + 1) {
+		_recordingFailed = false;
+		_recording.clear();
+		return false;
+	}
+	_cached = PutCachedFrames(_cacheKey, base::take(_recording));
+	_cachedKey = _cacheKey;
+	return true;
+}
+
 FFMpegReaderImplementation::Rotation FFMpegReaderImplementation::rotationFromDegrees(int degrees) const {
 	switch (degrees) {
 	case 90: return Rotation::Degrees90;
@@ -8,6 +8,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #pragma once
 
 #include "media/clip/media_clip_implementation.h"
+#include "media/clip/media_clip_frames_cache.h"
 #include "ffmpeg/ffmpeg_utility.h"
 
 extern "C" {
@@ -53,7 +54,15 @@ public:
 
 private:
 	ReadResult readNextFrame();
+	ReadResult readCachedFrame();
 	void processReadFrame();
+	void processFrameTiming(crl::time frameMs, int nextFrameDelay);
+
+	[[nodiscard]] bool cacheFrames() const;
+	void validateCacheKey(QSize size);
+	bool renderCachedFrame(QImage &to, bool &hasAlpha, QSize size);
+	void recordFrame(const QImage &frame, int index, bool alpha);
+	bool finishRecording();
 
 	enum class PacketResult {
 		Ok,
@@ -113,6 +122,15 @@ private:
 	crl::time _frameTime = 0;
 	crl::time _frameTimeCorrection = 0;
 
+	crl::time _framePosition = 0;
+	int _frameDuration = 0;
+
+	FramesCacheKey _cacheKey;
+	FramesCacheKey _cachedKey;
+	CachedFrames _cached;
+	std::vector<CachedFrame> _recording;
+	bool _recordingFailed = false;
+
 };
 
 } // namespace internal
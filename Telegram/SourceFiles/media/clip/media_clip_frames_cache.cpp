@@ -0,0 +1,144 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "media/clip/media_clip_frames_cache.h"
+
+#include <QtCore/QMutex>
+
+#include <xxhash.h> // XXH64.
+
+namespace Media {
+namespace Clip {
+namespace internal {
+namespace {
+
+constexpr auto kCacheSizeLimit = int64(64) * 1024 * 1024;
+constexpr auto kEntrySizeLimit = int64(16) * 1024 * 1024;
+constexpr auto kCompressionLevel = 1;
+
+struct Entry {
+	CachedFrames frames;
+	int64 size = 0;
+	uint64 used = 0;
+};
+
+struct Cache {
+	QMutex mutex;
+	base::flat_map<FramesCacheKey, Entry> entries;
+	int64 size = 0;
+	uint64 usedCounter = 0;
+};
+
+[[nodiscard]] Cache &Instance() {
+	static auto result = Cache();
+	return result;
+}
+
+// Must be locked: Cache::mutex.
+void ShrinkCache(Cache &cache) {
+	while (cache.size > kCacheSizeLimit && !cache.entries.empty()) {
+		const auto i = ranges::min_element(
+			cache.entries,
+			ranges::less(),
+			[](const auto &pair) { return pair.second.used; });
+		cache.size -= i->second.size;
+		cache.entries.erase(i);
+	}
+}
+
+} // namespace
+
+FramesCacheKey ComputeFramesCacheKey(
+		const QByteArray &data,
+		QSize size) {
+	if (data.isEmpty() || size.isEmpty()) {
+		return {};
+	}
+	return {
+		.hash = XXH64(data.constData(), data.size(), 0),
+		.bytes = data.size(),
+		.width = size.width(),
+		.height = size.height(),
+	};
+}
+
+CachedFrames FindCachedFrames(const FramesCacheKey &key) {
+	auto &cache = Instance();
+	QMutexLocker lock(&cache.mutex);
+	const auto i = cache.entries.find(key);
+	if (i == end(cache.entries)) {
+		return nullptr;
+	}
+	i->second.used = ++cache.usedCounter;
+	return i->second.frames;
+}
+
+CachedFrames PutCachedFrames(
+		const FramesCacheKey &key,
+		std::vector<CachedFrame> &&frames) {
+	auto size = int64();
+	for (const auto &frame : frames) {
+		size += frame.compressed.size();
+	}
+	auto result = std::make_shared<const std::vector<CachedFrame>>(
+		std::move(frames));
+	if (size > kEntrySizeLimit) {
+		return result;
+	}
+
+	auto &cache = Instance();
+	QMutexLocker lock(&cache.mutex);
+	auto &entry = cache.entries[key];
+	cache.size += size - entry.size;
+	entry.frames = result;
+	entry.size = size;
+	entry.used = ++cache.usedCounter;
+	ShrinkCache(cache);
+	return result;
+}
+
+CachedFrame CompressFrame(
+		const QImage &image,
+		crl::time position,
+		int duration,
+		bool alpha) {
+	Expects(image.format() == QImage::Format_ARGB32_Premultiplied);
+
+	const auto width = image.width();
+	const auto height = image.height();
+	const auto perLine = width * 4;
+	auto raw = QByteArray(perLine * height, Qt::Uninitialized);
+	auto to = raw.data();
+	for (auto y = 0; y != height; ++y, to += perLine) {
+		memcpy(to, image.constScanLine(y), perLine);
+	}
+	return {
+		.compressed = qCompress(raw, kCompressionLevel),
+		.position = position,
+		.duration = duration,
+		.alpha = alpha,
+	};
+}
+
+bool DecompressFrame(const CachedFrame &frame, QImage &to) {
+	const auto raw = qUncompress(frame.compressed);
+	const auto width = to.width();
+	const auto height = to.height();
+	const auto perLine = width * 4;
+	if (raw.size() != perLine * height) {
+		return false;
+	}
+	auto from = raw.constData();
+	for (auto y = 0; y != height; ++y, from += perLine) {
+		memcpy(to.scanLine(y), from, perLine);
+	}
+	return true;
+}
+
+} // namespace internal
+} // namespace Clip
+} // namespace Media
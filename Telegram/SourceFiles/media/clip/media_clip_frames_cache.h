@@ -0,0 +1,64 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+namespace Media {
+namespace Clip {
+namespace internal {
+
+// Looping webm stickers are decoded only once for each display size,
+// after that all clip readers of the same file play compressed frames
+// from this process-wide cache instead of decoding VP9 again.
+struct FramesCacheKey {
+	uint64 hash = 0;
+	int64 bytes = 0;
+	int width = 0;
+	int height = 0;
+
+	explicit operator bool() const {
+		return (bytes > 0);
+	}
+	friend inline auto operator<=>(
+		const FramesCacheKey&,
+		const FramesCacheKey&) = default;
+	friend inline bool operator==(
+		const FramesCacheKey&,
+		const FramesCacheKey&) = default;
+};
+
+struct CachedFrame {
+	QByteArray compressed;
+	crl::time position = 0;
+	int duration = 0;
+	bool alpha = false;
+};
+
+using CachedFrames = std::shared_ptr<const std::vector<CachedFrame>>;
+
+[[nodiscard]] FramesCacheKey ComputeFramesCacheKey(
+	const QByteArray &data,
+	QSize size);
+
+// Thread: Any.
+[[nodiscard]] CachedFrames FindCachedFrames(const FramesCacheKey &key);
+CachedFrames PutCachedFrames(
+	const FramesCacheKey &key,
+	std::vector<CachedFrame> &&frames);
+
+[[nodiscard]] CachedFrame CompressFrame(
+	const QImage &image,
+	crl::time position,
+	int duration,
+	bool alpha);
+
+// The image should be already allocated with the frame size.
+[[nodiscard]] bool DecompressFrame(const CachedFrame &frame, QImage &to);
+
+} // namespace internal
+} // namespace Clip
+} // namespace Media
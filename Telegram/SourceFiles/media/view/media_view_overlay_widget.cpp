@@ -118,6 +118,8 @@ constexpr auto kPreloadCount = 3;
 constexpr auto kMaxZoomLevel = 7; // x8
 constexpr auto kZoomToScreenLevel = 1024;
 constexpr auto kOverlayLoaderPriority = 2;
+constexpr auto kPreloadStreamPriority = 1;
+constexpr auto kPreloadStreamBytes = 4 * 1024 * 1024;
 constexpr auto kSeekTimeMs = 5 * crl::time(1000);
 
 // macOS OpenGL renderer fails to render larger texture
@@ -211,6 +213,26 @@ QWidget *PipDelegate::pipParentWidget() {
 		: read.image;
 }
 
+[[nodiscard]] QImage PrepareScaledContent(QImage image, QSize outer) {
+	auto result = image.scaled(
+		outer,
+		Qt::KeepAspectRatio,
+		Qt::SmoothTransformation);
+	result.setDevicePixelRatio(image.devicePixelRatio());
+	return result;
+}
+
+[[nodiscard]] int64 EstimatePreloadedBytes(
+		not_null<DocumentData*> document,
+		crl::time till) {
+	const auto duration = document->hasDuration()
+		? document->duration()
+		: crl::time(0);
+	return (duration > 0 && till > 0)
+		? (document->size * std::min(till, duration) / duration)
+		: 0;
+}
+
 [[nodiscard]] bool IsSemitransparent(const QImage &image) {
 	if (image.isNull()) {
 		return true;
@@ -995,6 +1017,10 @@ void OverlayWidget::updateControlsGeometry() {
 
 	updateControls();
 	resizeContentByScreenSize();
+	if (_staticContentScaledOuter
+		!= _widget->size() * style::DevicePixelRatio()) {
+		prepareStaticContentScaled();
+	}
 	update();
 }
 
@@ -1139,6 +1165,55 @@ void OverlayWidget::setStaticContent(QImage image) {
 	image.setDevicePixelRatio(cRetinaFactor());
 	_staticContent = std::move(image);
 	_staticContentTransparent = IsSemitransparent(_staticContent);
+	prepareStaticContentScaled();
+}
+
+void OverlayWidget::prepareStaticContentScaled() {
+	_staticContentScaled = QImage();
+	_staticContentScaledKey = 0;
+
+	// Zoomed out huge images are painted by the raster renderer from a
+	// copy that fits the screen, so that they are not downscaled from the
+	// full size on each frame. The OpenGL renderer uploads the full image
+	// once and lets the GPU scale it. The copy is prepared again when the
+	// window is resized or moved to another screen.
+	const auto outer = _widget->size() * style::DevicePixelRatio();
+	_staticContentScaledOuter = outer;
+	if (_opengl
+		|| outer.isEmpty()
+		|| (_staticContent.width() <= outer.width()
+			&& _staticContent.height() <= outer.height())) {
+		return;
+	}
+	const auto weak = Ui::MakeWeak(_widget);
+	const auto key = _staticContent.cacheKey();
+	crl::async([=, image = _staticContent] {
+		auto scaled = PrepareScaledContent(image, outer);
+		crl::on_main(weak, [=, scaled = std::move(scaled)]() mutable {
+			if (_staticContent.cacheKey() == key
+				&& _staticContentScaledOuter == outer) {
+				_staticContentScaled = std::move(scaled);
+				_staticContentScaledKey = key;
+			}
+		});
+	});
+}
+
+const QImage &OverlayWidget::staticContentForDisplay(
+		const ContentGeometry &geometry) const {
+	if (_staticContentScaled.isNull()
+		|| _staticContentScaledKey != _staticContent.cacheKey()) {
+		return _staticContent;
+	}
+	const auto factor = style::DevicePixelRatio();
+	const auto rotated = (int(base::SafeRound(geometry.rotation)) % 180);
+	const auto size = (rotated
+		? geometry.rect.size().transposed()
+		: geometry.rect.size()) * factor;
+	return (_staticContentScaled.width() < size.width()
+		|| _staticContentScaled.height() < size.height())
+		? _staticContent
+		: _staticContentScaled;
 }
 
 bool OverlayWidget::contentShown() const {
@@ -3373,7 +3448,7 @@ void OverlayWidget::displayPhoto(
 
 	refreshMediaViewer();
 
-	_staticContent = QImage();
+	setStaticContent(QImage());
 	if (!_stories && _photo->videoCanBePlayed()) {
 		initStreaming();
 	}
@@ -3426,7 +3501,7 @@ void OverlayWidget::displayDocument(
 		const Data::CloudTheme &cloud,
 		const StartStreaming &startStreaming) {
 	_fullScreenVideo = false;
-	_staticContent = QImage();
+	setStaticContent(QImage());
 	clearStreaming(_document != doc);
 	destroyThemePreview();
 	assignMediaPointer(doc);
@@ -3781,6 +3856,20 @@ bool OverlayWidget::createStreamingObjects() {
 		return false;
 	}
 	++_streamedCreated;
+	if (_document) {
+		// The player keeps the data of the neighbour preload, and it is
+		// restarted with our options in startStreamingPlayer. If the preload
+		// didn't pause on its first frame yet, the player still plays with
+		// the preload options and wouldn't be restarted, so stop it here.
+		const auto i = _preloadStreams.find(_document);
+		if (i != end(_preloadStreams)) {
+			const auto preload = std::move(i->second);
+			_preloadStreams.erase(i);
+			if (preload->player().playing()) {
+				preload->stop();
+			}
+		}
+	}
 	_streamed->instance.setPriority(kOverlayLoaderPriority);
 	_streamed->instance.lockPlayer();
 	_streamed->withSound = _document
@@ -4546,9 +4635,10 @@ void OverlayWidget::paint(not_null<Renderer*> renderer) {
 			const auto fillTransparentBackground = (!_document
 				|| (!_document->sticker() && !_document->isVideoMessage()))
 				&& _staticContentTransparent;
+			const auto geometry = contentGeometry();
 			renderer->paintTransformedStaticContent(
-				_staticContent,
-				contentGeometry(),
+				staticContentForDisplay(geometry),
+				geometry,
 				_staticContentTransparent,
 				fillTransparentBackground);
 		}
@@ -5494,6 +5584,87 @@ void OverlayWidget::preloadData(int delta) {
 	}
 	_preloadPhotos = std::move(photos);
 	_preloadDocuments = std::move(documents);
+	preloadStreams();
+}
+
+void OverlayWidget::preloadStreams() {
+	Expects(_index.has_value());
+
+	// Open the nearest videos paused on their first frame, so that the
+	// header and the first frame are already there when we swipe to them.
+	auto streams = base::flat_map<
+		not_null<DocumentData*>,
+		std::unique_ptr<Streaming::Instance>>();
+	for (const auto index : { *_index - 1, *_index + 1 }) {
+		const auto entity = entityByIndex(index);
+		const auto document = std::get_if<not_null<DocumentData*>>(
+			&entity.data);
+		if (!document
+			|| !((*document)->isVideoFile() || (*document)->isAnimation())
+			|| (*document)->loaded()) {
+			continue;
+		} else if (auto i = _preloadStreams.find(*document)
+			; i != end(_preloadStreams)) {
+			streams.emplace(*document, std::move(i->second));
+			continue;
+		}
+		auto instance = std::make_unique<Streaming::Instance>(
+			*document,
+			fileOrigin(entity),
+			nullptr);
+		if (!instance->valid()) {
+			continue;
+		}
+		instance->setPriority(kPreloadStreamPriority);
+		if (!instance->player().active()) {
+			startPreloadStream(*document, instance.get());
+		}
+		streams.emplace(*document, std::move(instance));
+	}
+	_preloadStreams = std::move(streams);
+}
+
+void OverlayWidget::startPreloadStream(
+		not_null<DocumentData*> document,
+		not_null<Streaming::Instance*> instance) {
+	using namespace Streaming;
+
+	// Keep only the first frame and stop reading past the byte budget,
+	// the player is restarted with our own options when we show it.
+	const auto paused = std::make_shared<bool>();
+	const auto weak = Ui::MakeWeak(_widget);
+	const auto stop = [=] {
+		crl::on_main(weak, [=] {
+			const auto i = _preloadStreams.find(document);
+			if (i != end(_preloadStreams)
+				&& i->second.get() == instance
+				&& instance->player().active()
+				&& (!*paused || instance->paused())) {
+				instance->stop();
+			}
+		});
+	};
+	instance->player().updates(
+	) | rpl::start_with_next_error([=](Update &&update) {
+		v::match(update.data, [&](const Information &) {
+			if (!*paused) {
+				*paused = true;
+				instance->pause();
+			}
+		}, [&](const PreloadedVideo &update) {
+			if (EstimatePreloadedBytes(document, update.till)
+				> kPreloadStreamBytes) {
+				stop();
+			}
+		}, [](const auto &) {
+		});
+	}, [](Error &&) {
+	}, instance->lifetime());
+
+	auto options = PlaybackOptions();
+	options.mode = Mode::Video;
+	options.waitForMarkAsShown = true;
+	instance->play(options);
 }
 
 void OverlayWidget::handleMousePress(
@@ -6138,6 +6309,7 @@ void OverlayWidget::clearBeforeHide() {
 	assignMediaPointer(nullptr);
 	_preloadPhotos.clear();
 	_preloadDocuments.clear();
+	_preloadStreams.clear();
 	if (_menu) {
 		_menu->hideMenu(true);
 	}
@@ -6154,7 +6326,7 @@ void OverlayWidget::clearAfterHide() {
 	clearStreaming();
 	destroyThemePreview();
 	_radial.stop();
-	_staticContent = QImage();
+	setStaticContent(QImage());
 	_themePreview = nullptr;
 	_themeApply.destroyDelayed();
 	_themeCancel.destroyDelayed();
@@ -64,6 +64,7 @@ struct TrackState;
 } // namespace Media::Player
 
 namespace Media::Streaming {
+class Instance;
 struct Information;
 struct Update;
 struct FrameWithInfo;
@@ -308,6 +309,10 @@ private:
 	void updateGeometryToScreen(bool inMove = false);
 	bool moveToNext(int delta);
 	void preloadData(int delta);
+	void preloadStreams();
+	void startPreloadStream(
+		not_null<DocumentData*> document,
+		not_null<Streaming::Instance*> instance);
 
 	void handleScreenChanged(QScreen *screen);
 
@@ -519,6 +524,9 @@ private:
 	[[nodiscard]] bool documentContentShown() const;
 	[[nodiscard]] bool documentBubbleShown() const;
 	void setStaticContent(QImage image);
+	void prepareStaticContentScaled();
+	[[nodiscard]] const QImage &staticContentForDisplay(
+		const ContentGeometry &geometry) const;
 	[[nodiscard]] bool contentShown() const;
 	[[nodiscard]] bool opaqueContentShown() const;
 	void clearStreaming(bool savePosition = true);
@@ -556,6 +564,9 @@ private:
 	std::shared_ptr<Data::DocumentMedia> _documentMedia;
 	base::flat_set<std::shared_ptr<Data::PhotoMedia>> _preloadPhotos;
 	base::flat_set<std::shared_ptr<Data::DocumentMedia>> _preloadDocuments;
+	base::flat_map<
+		not_null<DocumentData*>,
+		std::unique_ptr<Streaming::Instance>> _preloadStreams;
 	int _rotation = 0;
 	std::unique_ptr<SharedMedia> _sharedMedia;
 	std::optional<SharedMediaWithLastSlice> _sharedMediaData;
@@ -613,6 +624,9 @@ private:
 	bool _pressed = false;
 	int32 _dragging = 0;
 	QImage _staticContent;
+	QImage _staticContentScaled;
+	qint64 _staticContentScaledKey = 0;
+	QSize _staticContentScaledOuter;
 	bool _staticContentTransparent = false;
 	bool _blurred = true;
 	bool _reShow = false;
@@ -454,6 +454,40 @@ void Photo::clearHeavyPart() {
 	_dataMedia = nullptr;
 }
 
+void Photo::preloadHeavyPart() {
+	if (_spoiler || _pixPreparing || _width <= 0 || _height <= 0) {
+		return;
+	} else if (_goodLoaded && _pix.width() == _width * cIntRetinaFactor()) {
+		return;
+	}
+	ensureDataMediaCreated();
+	const auto image = _dataMedia->image(Data::PhotoSize::Large)
+		? _dataMedia->image(Data::PhotoSize::Large)
+		: _dataMedia->image(Data::PhotoSize::Thumbnail);
+	if (!image) {
+		return;
+	}
+
+	// Prepare the thumbnail in the background, paint() will use it
+	// if it wasn't forced to prepare it synchronously before.
+	_pixPreparing = true;
+	const auto width = _width;
+	const auto height = _height;
+	const auto weak = base::make_weak(this);
+	crl::async([=, original = image->original()]() mutable {
+		auto prepared = CropMediaFrame(std::move(original), width, height);
+		crl::on_main(weak, [=, prepared = std::move(prepared)]() mutable {
+			_pixPreparing = false;
+			if (_goodLoaded || _width != width || _height != height) {
+				return;
+			}
+			_goodLoaded = true;
+			_pix = Ui::PixmapFromImage(std::move(prepared));
+			delegate()->repaintItem(this);
+		});
+	});
+}
+
 TextState Photo::getState(
 		QPoint point,
 		StateRequest request) const {
@@ -623,6 +657,42 @@ void Video::clearHeavyPart() {
 	_dataMedia = nullptr;
 }
 
+void Video::preloadHeavyPart() {
+	if (_spoiler || _pixPreparing || _width <= 0 || _height <= 0) {
+		return;
+	} else if (!_pixBlurred && _pix.width() == _width * cIntRetinaFactor()) {
+		return;
+	}
+	ensureDataMediaCreated();
+	const auto good = _dataMedia->goodThumbnail();
+	const auto image = good ? good : _dataMedia->thumbnail();
+	if (!image) {
+		return;
+	}
+
+	// Prepare the thumbnail in the background, paint() will use it
+	// if it wasn't forced to prepare it synchronously before.
+	_pixPreparing = true;
+	const auto width = _width;
+	const auto height = _height;
+	const auto weak = base::make_weak(this);
+	crl::async([=, original = image->original()]() mutable {
+		auto prepared = CropMediaFrame(std::move(original), width, height);
+		crl::on_main(weak, [=, prepared = std::move(prepared)]() mutable {
+			_pixPreparing = false;
+			if (_width != width || _height != height) {
+				return;
+			} else if (!_pixBlurred
+				&& _pix.width() == _width * cIntRetinaFactor()) {
+				return;
+			}
+			_pixBlurred = false;
+			_pix = Ui::PixmapFromImage(std::move(prepared));
+			delegate()->repaintItem(this);
+		});
+	});
+}
+
 float64 Video::dataProgress() const {
 	ensureDataMediaCreated();
 	return _dataMedia->progress();
@@ -74,6 +74,10 @@ public:
 	virtual void clearHeavyPart() {
 	}
 
+	// Called for items that are about to enter the viewport.
+	virtual void preloadHeavyPart() {
+	}
+
 protected:
 	[[nodiscard]] not_null<HistoryItem*> parent() const {
 		return _parent;
@@ -205,6 +209,7 @@ public:
 		StateRequest request) const override;
 
 	void clearHeavyPart() override;
+	void preloadHeavyPart() override;
 
 private:
 	void ensureDataMediaCreated() const;
@@ -218,6 +223,7 @@ private:
 
 	QPixmap _pix;
 	bool _goodLoaded = false;
+	bool _pixPreparing = false;
 	bool _story = false;
 
 };
@@ -297,6 +303,7 @@ public:
 		StateRequest request) const override;
 
 	void clearHeavyPart() override;
+	void preloadHeavyPart() override;
 	void clearSpoiler() override;
 
 protected:
@@ -318,6 +325,7 @@ private:
 
 	QPixmap _pix;
 	bool _pixBlurred = true;
+	bool _pixPreparing = false;
 	bool _story = false;
 
 };
@@ -11,6 +11,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "mainwidget.h"
 #include "mainwindow.h"
 #include "data/data_session.h"
+#include "data/data_histories.h"
 #include "data/data_cloud_themes.h"
 #include "main/main_session.h"
 #include "main/main_account.h"
@@ -26,6 +27,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "window/themes/window_theme.h"
 #include "window/themes/window_theme_editor.h"
 #include "window/window_session_controller.h"
+#include "media/audio/media_audio.h"
 #include "media/audio/media_audio_track.h"
 #include "settings/settings_folders.h"
 #include "api/api_updates.h"
@@ -245,6 +247,57 @@ auto GenerateCodes() {
 			});
 		});
 	});
+	codes.emplace(u"benchchatlist"_q, [](SessionController *window) {
+		const auto main = window ? window->widget()->sessionContent() : nullptr;
+		const auto done = [](QString summary) {
+			Ui::Toast::Show(summary.isEmpty()
+				? u"Chats list was hidden."_q
+				: summary);
+		};
+		if (!main || !main->dialogsBenchmarkPaint(done)) {
+			Ui::Toast::Show(u"Chats list is not shown."_q);
+		}
+	});
+	codes.emplace(u"historyarenas"_q, [](SessionController *window) {
+		if (!window) {
+			return;
+		}
+		const auto stats = window->session().data().histories().arenaStats();
+		const auto kb = [](int64 bytes) {
+			return QString::number(bytes / 1024);
+		};
+		Ui::Toast::Show(u"%1 allocations, %2 objects in %3 slabs, %4 / %5 KB"_q
+			.arg(stats.allocations)
+			.arg(stats.objects)
+			.arg(stats.slabs)
+			.arg(kb(stats.usedBytes))
+			.arg(kb(stats.reservedBytes)));
+	});
+	codes.emplace(u"residentchats"_q, [](SessionController *window) {
+		if (!window) {
+			return;
+		}
+		const auto stats = window->session().data().histories().residentStats();
+		const auto mb = [](int64 bytes) {
+			return QString::number(bytes / (1024 * 1024));
+		};
+		Ui::Toast::Show(u"%1 chats, views %2 / %3 MB, items %4 MB, %5 unloaded"_q
+			.arg(stats.histories)
+			.arg(mb(stats.viewsSize))
+			.arg(mb(stats.budget))
+			.arg(mb(stats.itemsSize))
+			.arg(stats.evictions));
+	});
+	codes.emplace(u"audiostats"_q, [](SessionController *window) {
+		const auto mixer = Media::Player::mixer();
+		if (!mixer) {
+			return;
+		}
+		const auto stats = mixer->statistics();
+		Ui::Toast::Show(u"%1 underruns, %2 ms max feed latency"_q
+			.arg(stats.underruns)
+			.arg(stats.feedLatencyMax));
+	});
 	codes.emplace(u"testchatcolors"_q, [](SessionController *window) {
 		const auto now = !Data::CloudThemes::TestingColors();
 		Data::CloudThemes::SetTestingColors(now);
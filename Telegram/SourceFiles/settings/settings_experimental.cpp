@@ -31,6 +31,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "window/notifications_manager.h"
 #include "storage/localimageloader.h"
 #include "data/data_document_resolver.h"
+#include "data/data_histories.h"
 #include "styles/style_settings.h"
 #include "styles/style_layers.h"
 
@@ -153,6 +154,7 @@ void SetupExperimental(
 	addToggle(Window::Notifications::kOptionGNotification);
 	addToggle(Core::kOptionFreeType);
 	addToggle(Data::kOptionExternalVideoPlayer);
+	addToggle(Data::kOptionKeepFewerChatsLoaded);
 }
 
 } // namespace
@@ -11,6 +11,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "storage/storage_domain.h"
 #include "storage/storage_encryption.h"
 #include "storage/storage_clear_legacy.h"
+#include "storage/storage_shared_media.h"
 #include "storage/cache/storage_cache_types.h"
 #include "storage/details/storage_file_utilities.h"
 #include "storage/details/storage_settings_scheme.h"
@@ -90,6 +91,7 @@ enum { // Local Storage Keys
 	lskSelfSerialized = 0x15, // serialized self
 	lskMasksKeys = 0x16, // no data
 	lskCustomEmojiKeys = 0x17, // no data
+	lskSharedMediaCounts = 0x18, // no data
 };
 
 auto EmptyMessageDraftSources()
@@ -140,10 +142,14 @@ Account::Account(not_null<Main::Account*> owner, const QString &dataName)
 , _cacheTotalTimeLimit(Database::Settings().totalTimeLimit)
 , _cacheBigFileTotalTimeLimit(Database::Settings().totalTimeLimit)
 , _writeMapTimer([=] { writeMap(); })
-, _writeLocationsTimer([=] { writeLocations(); }) {
+, _writeLocationsTimer([=] { writeLocations(); })
+, _writeSharedMediaCountsTimer([=] { writeSharedMediaCounts(); }) {
 }
 
 Account::~Account() {
+	if (_localKey && _writeSharedMediaCountsTimer.isActive()) {
+		writeSharedMediaCounts();
+	}
 	if (_localKey && _mapChanged) {
 		writeMap();
 	}
@@ -224,6 +230,7 @@ base::flat_set<QString> Account::collectGoodNames() const {
 		_installedCustomEmojiKey,
 		_featuredCustomEmojiKey,
 		_archivedCustomEmojiKey,
+		_sharedMediaCountsKey,
 	};
 	auto result = base::flat_set<QString>{
 		"map0",
@@ -302,6 +309,7 @@ Account::ReadMapResult Account::readMapWith(
 	base::flat_map<PeerId, FileKey> draftCursorsMap;
 	base::flat_map<PeerId, bool> draftsNotReadMap;
 	quint64 locationsKey = 0, reportSpamStatusesKey = 0, trustedBotsKey = 0;
+	quint64 sharedMediaCountsKey = 0;
 	quint64 recentStickersKeyOld = 0;
 	quint64 installedStickersKey = 0, featuredStickersKey = 0, recentStickersKey = 0, favedStickersKey = 0, archivedStickersKey = 0;
 	quint64 installedMasksKey = 0, recentMasksKey = 0, archivedMasksKey = 0;
@@ -362,6 +370,9 @@ Account::ReadMapResult Account::readMapWith(
 		case lskTrustedBots: {
 			map.stream >> trustedBotsKey;
 		} break;
+		case lskSharedMediaCounts: {
+			map.stream >> sharedMediaCountsKey;
+		} break;
 		case lskRecentStickersOld: {
 			map.stream >> recentStickersKeyOld;
 		} break;
@@ -431,6 +442,7 @@ Account::ReadMapResult Account::readMapWith(
 
 	_locationsKey = locationsKey;
 	_trustedBotsKey = trustedBotsKey;
+	_sharedMediaCountsKey = sharedMediaCountsKey;
 	_recentStickersKeyOld = recentStickersKeyOld;
 	_installedStickersKey = installedStickersKey;
 	_featuredStickersKey = featuredStickersKey;
@@ -539,6 +551,7 @@ void Account::writeMap() {
 	if (!_draftCursorsMap.empty()) mapSize += sizeof(quint32) * 2 + _draftCursorsMap.size() * sizeof(quint64) * 2;
 	if (_locationsKey) mapSize += sizeof(quint32) + sizeof(quint64);
 	if (_trustedBotsKey) mapSize += sizeof(quint32) + sizeof(quint64);
+	if (_sharedMediaCountsKey) mapSize += sizeof(quint32) + sizeof(quint64);
 	if (_recentStickersKeyOld) mapSize += sizeof(quint32) + sizeof(quint64);
 	if (_installedStickersKey || _featuredStickersKey || _recentStickersKey || _archivedStickersKey) {
 		mapSize += sizeof(quint32) + 4 * sizeof(quint64);
@@ -577,6 +590,9 @@ void Account::writeMap() {
 	if (_trustedBotsKey) {
 		mapData.stream << quint32(lskTrustedBots) << quint64(_trustedBotsKey);
 	}
+	if (_sharedMediaCountsKey) {
+		mapData.stream << quint32(lskSharedMediaCounts) << quint64(_sharedMediaCountsKey);
+	}
 	if (_recentStickersKeyOld) {
 		mapData.stream << quint32(lskRecentStickersOld) << quint64(_recentStickersKeyOld);
 	}
@@ -624,6 +640,10 @@ void Account::reset() {
 	_draftCursorsMap.clear();
 	_draftsNotReadMap.clear();
 	_locationsKey = _trustedBotsKey = 0;
+	_sharedMediaCountsKey = 0;
+	_sharedMediaCounts = nullptr;
+	_sharedMediaCountsRead = false;
+	_writeSharedMediaCountsTimer.cancel();
 	_recentStickersKeyOld = 0;
 	_installedStickersKey = 0;
 	_featuredStickersKey = 0;
@@ -3008,6 +3028,87 @@ bool Account::isBotTrustedOpenWebView(PeerId botId) {
 		&& ((i->second & BotTrustFlag::OpenWebView) != 0);
 }
 
+void Account::writeSharedMediaCounts() {
+	_writeSharedMediaCountsTimer.cancel();
+	if (!_localKey) {
+		return;
+	} else if (!_sharedMediaCounts || _sharedMediaCounts->empty()) {
+		if (_sharedMediaCountsKey) {
+			ClearKey(_sharedMediaCountsKey, _basePath);
+			_sharedMediaCountsKey = 0;
+			writeMapDelayed();
+		}
+		return;
+	}
+	if (!_sharedMediaCountsKey) {
+		_sharedMediaCountsKey = GenerateKey(_basePath);
+		writeMapQueued();
+	}
+	const auto serialized = _sharedMediaCounts->serialize();
+	EncryptedDescriptor data(Serialize::bytearraySize(serialized));
+	data.stream << serialized;
+
+	FileWriteDescriptor file(_sharedMediaCountsKey, _basePath);
+	file.writeEncrypted(data, _localKey);
+}
+
+void Account::readSharedMediaCounts() {
+	if (_sharedMediaCountsRead) {
+		return;
+	}
+	_sharedMediaCountsRead = true;
+	_sharedMediaCounts = std::make_unique<SharedMediaCounts>();
+	if (!_sharedMediaCountsKey) {
+		return;
+	}
+
+	FileReadDescriptor counts;
+	if (!ReadEncryptedFile(
+			counts,
+			_sharedMediaCountsKey,
+			_basePath,
+			_localKey)) {
+		ClearKey(_sharedMediaCountsKey, _basePath);
+		_sharedMediaCountsKey = 0;
+		writeMapDelayed();
+		return;
+	}
+
+	auto serialized = QByteArray();
+	counts.stream >> serialized;
+	if (!CheckStreamStatus(counts.stream)
+		|| !_sharedMediaCounts->deserialize(serialized)) {
+		LOG(("App Error: could not read shared media counts."));
+		_sharedMediaCounts = std::make_unique<SharedMediaCounts>();
+	}
+}
+
+std::optional<int> Account::sharedMediaCount(
+		PeerId peerId,
+		SharedMediaType type) {
+	readSharedMediaCounts();
+	return _sharedMediaCounts->count(peerId, type);
+}
+
+void Account::setSharedMediaCount(
+		PeerId peerId,
+		SharedMediaType type,
+		int count) {
+	readSharedMediaCounts();
+	if (_sharedMediaCounts->set(peerId, type, count)
+		&& !_writeSharedMediaCountsTimer.isActive()) {
+		_writeSharedMediaCountsTimer.callOnce(kDelayedWriteTimeout);
+	}
+}
+
+void Account::removeSharedMediaCounts(PeerId peerId) {
+	readSharedMediaCounts();
+	if (_sharedMediaCounts->remove(peerId)
+		&& !_writeSharedMediaCountsTimer.isActive()) {
+		_writeSharedMediaCountsTimer.callOnce(kDelayedWriteTimeout);
+	}
+}
+
 bool Account::encrypt(
 		const void *src,
 		void *dst,
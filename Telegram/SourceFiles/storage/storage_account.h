@@ -49,6 +49,8 @@ struct FileReadDescriptor;
 } // namespace details
 
 class EncryptionKey;
+class SharedMediaCounts;
+enum class SharedMediaType : signed char;
 
 using FileKey = quint64;
 
@@ -173,6 +175,15 @@ public:
 	void markBotTrustedOpenWebView(PeerId botId);
 	[[nodiscard]] bool isBotTrustedOpenWebView(PeerId botId);
 
+	[[nodiscard]] std::optional<int> sharedMediaCount(
+		PeerId peerId,
+		SharedMediaType type);
+	void setSharedMediaCount(
+		PeerId peerId,
+		SharedMediaType type,
+		int count);
+	void removeSharedMediaCounts(PeerId peerId);
+
 	[[nodiscard]] bool encrypt(
 		const void *src,
 		void *dst,
@@ -254,6 +265,9 @@ private:
 	void readTrustedBots();
 	void writeTrustedBots();
 
+	void readSharedMediaCounts();
+	void writeSharedMediaCounts();
+
 	std::optional<RecentHashtagPack> saveRecentHashtags(
 		Fn<RecentHashtagPack()> getPack,
 		const QString &text);
@@ -301,6 +315,7 @@ private:
 	FileKey _installedCustomEmojiKey = 0;
 	FileKey _featuredCustomEmojiKey = 0;
 	FileKey _archivedCustomEmojiKey = 0;
+	FileKey _sharedMediaCountsKey = 0;
 
 	qint64 _cacheTotalSizeLimit = 0;
 	qint64 _cacheBigFileTotalSizeLimit = 0;
@@ -309,6 +324,8 @@ private:
 
 	base::flat_map<PeerId, base::flags<BotTrustFlag>> _trustedBots;
 	bool _trustedBotsRead = false;
+	std::unique_ptr<SharedMediaCounts> _sharedMediaCounts;
+	bool _sharedMediaCountsRead = false;
 	bool _readingUserSettings = false;
 	bool _recentHashtagsAndBotsWereRead = false;
 
@@ -316,6 +333,7 @@ private:
 
 	base::Timer _writeMapTimer;
 	base::Timer _writeLocationsTimer;
+	base::Timer _writeSharedMediaCountsTimer;
 	bool _mapChanged = false;
 	bool _locationsChanged = false;
 
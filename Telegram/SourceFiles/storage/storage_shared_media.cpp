@@ -10,6 +10,231 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include <rpl/map.h>
 
 namespace Storage {
+namespace {
+
+constexpr auto kCountsVersion = 1;
+constexpr auto kCountsMaxPeers = 4096;
+constexpr auto kCountsShrinkTo = kCountsMaxPeers * 3 / 4;
+
+void AppendVarint(QByteArray &to, uint64 value) {
+	while (value >= 0x80) {
+		to.append(char((value & 0x7F) | 0x80));
+		value >>= 7;
+	}
+	to.append(char(value));
+}
+
+[[nodiscard]] bool ReadVarint(
+		const char *&from,
+		const char *till,
+		uint64 &value) {
+	value = 0;
+	for (auto shift = 0; from != till && shift < 64; shift += 7) {
+		const auto byte = uchar(*from++);
+		value |= uint64(byte & 0x7F) << shift;
+		if (!(byte & 0x80)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+} // namespace
+
+std::optional<int> SharedMediaCounts::count(
+		PeerId peerId,
+		SharedMediaType type) const {
+	Expects(IsValidSharedMediaType(type));
+
+	const auto row = findRow(peerId);
+	if (row < 0) {
+		return std::nullopt;
+	}
+	const auto value = _counts[static_cast<int>(type)][row];
+	return (value >= 0) ? std::make_optional(int(value)) : std::nullopt;
+}
+
+bool SharedMediaCounts::set(PeerId peerId, SharedMediaType type, int count) {
+	Expects(IsValidSharedMediaType(type));
+	Expects(count >= 0);
+
+	auto row = findRow(peerId);
+	if (row < 0) {
+		row = insertRow(peerId);
+	}
+	_used[row] = ++_usedCounter;
+	auto &value = _counts[static_cast<int>(type)][row];
+	if (value == count) {
+		return false;
+	}
+	value = count;
+	if (int(_peers.size()) > kCountsMaxPeers) {
+		shrink();
+	}
+	return true;
+}
+
+bool SharedMediaCounts::remove(PeerId peerId) {
+	const auto row = findRow(peerId);
+	if (row < 0) {
+		return false;
+	}
+	_peers.erase(begin(_peers) + row);
+	_used.erase(begin(_used) + row);
+	for (auto &column : _counts) {
+		column.erase(begin(column) + row);
+	}
+	return true;
+}
+
+bool SharedMediaCounts::empty() const {
+	return _peers.empty();
+}
+
+int SharedMediaCounts::findRow(PeerId peerId) const {
+	const auto i = ranges::lower_bound(_peers, peerId);
+	return (i != end(_peers) && *i == peerId)
+		? int(i - begin(_peers))
+		: -1;
+}
+
+int SharedMediaCounts::insertRow(PeerId peerId) {
+	const auto i = ranges::lower_bound(_peers, peerId);
+	const auto row = int(i - begin(_peers));
+	_peers.insert(i, peerId);
+	_used.insert(begin(_used) + row, 0);
+	for (auto &column : _counts) {
+		column.insert(begin(column) + row, -1);
+	}
+	return row;
+}
+
+void SharedMediaCounts::shrink() {
+	auto sorted = _used;
+	const auto drop = int(sorted.size()) - kCountsShrinkTo;
+	ranges::nth_element(sorted, begin(sorted) + drop);
+	const auto threshold = sorted[drop];
+
+	auto to = 0;
+	for (auto row = 0, count = int(_peers.size()); row != count; ++row) {
+		if (_used[row] < threshold) {
+			continue;
+		} else if (to != row) {
+			_peers[to] = _peers[row];
+			_used[to] = _used[row];
+			for (auto &column : _counts) {
+				column[to] = column[row];
+			}
+		}
+		++to;
+	}
+	_peers.resize(to);
+	_used.resize(to);
+	for (auto &column : _counts) {
+		column.resize(to);
+	}
+}
+
+QByteArray SharedMediaCounts::serialize() const {
+	const auto count = int(_peers.size());
+
+	// Peer ids are written sorted by their serialized value as deltas.
+	auto order = std::vector<std::pair<uint64, int>>();
+	order.reserve(count);
+	for (auto row = 0; row != count; ++row) {
+		order.emplace_back(SerializePeerId(_peers[row]), row);
+	}
+	ranges::sort(order);
+
+	auto result = QByteArray();
+	result.reserve(8 + count * (4 + kSharedMediaTypeCount));
+	AppendVarint(result, kCountsVersion);
+	AppendVarint(result, kSharedMediaTypeCount);
+	AppendVarint(result, count);
+	auto previous = uint64();
+	for (const auto &[serialized, row] : order) {
+		AppendVarint(result, serialized - previous);
+		previous = serialized;
+	}
+	for (const auto &[serialized, row] : order) {
+		AppendVarint(result, _used[row]);
+	}
+	for (const auto &column : _counts) {
+		for (const auto &[serialized, row] : order) {
+			AppendVarint(result, uint64(int64(column[row]) + 1));
+		}
+	}
+	return result;
+}
+
+bool SharedMediaCounts::deserialize(const QByteArray &serialized) {
+	auto from = serialized.constData();
+	const auto till = from + serialized.size();
+	auto version = uint64();
+	auto types = uint64();
+	auto count = uint64();
+	if (!ReadVarint(from, till, version)
+		|| version != kCountsVersion
+		|| !ReadVarint(from, till, types)
+		|| !ReadVarint(from, till, count)
+		|| count > uint64(till - from)) {
+		return false;
+	}
+	auto peers = std::vector<PeerId>(count);
+	auto used = std::vector<uint32>(count);
+	auto counts = std::array<std::vector<int32>, kSharedMediaTypeCount>();
+	for (auto &column : counts) {
+		column.resize(count, -1);
+	}
+	auto value = uint64();
+	auto previous = uint64();
+	for (auto &peerId : peers) {
+		if (!ReadVarint(from, till, value)) {
+			return false;
+		}
+		previous += value;
+		peerId = DeserializePeerId(previous);
+	}
+	for (auto &entry : used) {
+		if (!ReadVarint(from, till, value)) {
+			return false;
+		}
+		entry = uint32(value);
+	}
+	for (auto type = uint64(); type != types; ++type) {
+		for (auto row = 0; row != int(count); ++row) {
+			if (!ReadVarint(from, till, value)) {
+				return false;
+			} else if (type < uint64(kSharedMediaTypeCount)
+				&& value <= uint64(std::numeric_limits<int32>::max())) {
+				counts[type][row] = int32(value) - 1;
+			}
+		}
+	}
+
+	// Serialized order differs from the PeerId order, sort the rows.
+	auto order = ranges::views::ints(0, int(count))
+		| ranges::to_vector;
+	ranges::sort(order, ranges::less(), [&](int row) { return peers[row]; });
+	_peers.clear();
+	_used.clear();
+	_usedCounter = 0;
+	for (auto &column : _counts) {
+		column.clear();
+	}
+	for (const auto row : order) {
+		if (!_peers.empty() && _peers.back() == peers[row]) {
+			continue;
+		}
+		_peers.push_back(peers[row]);
+		_used.push_back(used[row]);
+		_usedCounter = std::max(_usedCounter, used[row]);
+		for (auto i = 0; i != kSharedMediaTypeCount; ++i) {
+			_counts[i].push_back(counts[i][row]);
+		}
+	}
+	return true;
+}
 
 auto SharedMedia::enforceLists(Key key)
 -> std::map<Key, SharedMedia::Lists>::iterator {
@@ -221,6 +221,39 @@ struct SharedMediaUnloadThread {
 	MsgId topicRootId = 0;
 };
 
+// Last known full counts of all the shared media types by peer.
+//
+// Counts are stored in columns, one per type, sharing a sorted column
+// of peer ids, so all types of a peer are answered by one lookup and
+// the serialized form (peer ids delta-encoded, all values as varints)
+// stays compact enough to be written to the local storage as a whole.
+class SharedMediaCounts final {
+public:
+	[[nodiscard]] std::optional<int> count(
+		PeerId peerId,
+		SharedMediaType type) const;
+
+	// Both return true if something has changed.
+	bool set(PeerId peerId, SharedMediaType type, int count);
+	bool remove(PeerId peerId);
+
+	[[nodiscard]] bool empty() const;
+
+	[[nodiscard]] QByteArray serialize() const;
+	bool deserialize(const QByteArray &serialized);
+
+private:
+	[[nodiscard]] int findRow(PeerId peerId) const;
+	int insertRow(PeerId peerId);
+	void shrink();
+
+	std::vector<PeerId> _peers;
+	std::vector<uint32> _used;
+	std::array<std::vector<int32>, kSharedMediaTypeCount> _counts;
+	uint32 _usedCounter = 0;
+
+};
+
 class SharedMedia {
 public:
 	using Type = SharedMediaType;
@@ -274,7 +274,6 @@ TemplatesIndex ComputeIndex(const TemplatesData &data) {
 	using Id = TemplatesIndex::Id;
 	using Term = TemplatesIndex::Term;
 
-	auto uniqueFirst = std::map<QChar, base::flat_set<Id>>();
 	auto uniqueFull = std::map<Id, base::flat_set<Term>>();
 	const auto pushString = [&](
 			const Id &id,
@@ -282,7 +281,6 @@ TemplatesIndex ComputeIndex(const TemplatesData &data) {
 			int weight) {
 		const auto list = TextUtilities::PrepareSearchWords(string);
 		for (const auto &word : list) {
-			uniqueFirst[word[0]].emplace(id);
 			uniqueFull[id].emplace(std::make_pair(word, weight));
 		}
 	};
@@ -298,9 +296,6 @@ TemplatesIndex ComputeIndex(const TemplatesData &data) {
 	}
 
 	auto result = TemplatesIndex();
-	for (const auto &[ch, unique] : uniqueFirst) {
-		result.first.emplace(ch, unique | ranges::to_vector);
-	}
 	for (const auto &[id, unique] : uniqueFull) {
 		result.full.emplace(id, unique | ranges::to_vector);
 	}
@@ -321,25 +316,6 @@ void ReplaceFileIndex(
 	for (auto &[id, list] : source.full) {
 		result.full.emplace(id, std::move(list));
 	}
-
-	using Id = TemplatesIndex::Id;
-	for (auto &[ch, list] : result.first) {
-		auto i = ranges::lower_bound(
-			list,
-			std::make_pair(path, QString()));
-		auto j = std::find_if(i, end(list), [&](const Id &id) {
-			return id.first != path;
-		});
-		list.erase(i, j);
-	}
-	for (auto &[ch, list] : source.first) {
-		auto &to = result.first[ch];
-		to.insert(
-			end(to),
-			std::make_move_iterator(begin(list)),
-			std::make_move_iterator(end(list)));
-		ranges::sort(to);
-	}
 }
 
 void MoveKeys(TemplatesFile &to, const TemplatesFile &from) {
@@ -489,6 +465,7 @@ void Templates::load() {
 		]() mutable {
 			setData(std::move(result.result));
 			_index = std::move(result.index);
+			refreshSearchIndex();
 			_errors.fire(std::move(result.errors));
 			crl::on_main(this, [=] {
 				if (base::take(_reloadAfterRead)) {
@@ -578,6 +555,7 @@ void Templates::updateRequestFinished(QNetworkReply *reply) {
 			auto &parsed = one.files.at(path);
 			MoveKeys(parsed, existing);
 			ReplaceFileIndex(_index, ComputeIndex(one), path);
+			refreshSearchIndex();
 			if (!errors.isEmpty()) {
 				_errors.fire(std::move(errors));
 			}
@@ -659,20 +637,27 @@ auto Templates::matchFromEnd(QString query) const
 	return result;
 }
 
+void Templates::refreshSearchIndex() {
+	_searchIds.clear();
+	_searchIndex.clear();
+	_searchIds.reserve(_index.full.size());
+	for (const auto &[id, terms] : _index.full) {
+		auto words = base::flat_set<QString>();
+		words.reserve(terms.size());
+		for (const auto &[term, weight] : terms) {
+			words.emplace(term);
+		}
+		_searchIndex.add(int(_searchIds.size()), words);
+		_searchIds.push_back(id);
+	}
+}
+
 Templates::~Templates() = default;
 
 auto Templates::query(const QString &text) const -> std::vector<Question> {
 	const auto words = TextUtilities::PrepareSearchWords(text);
-	const auto questions = [&](const QString &word) {
-		const auto i = _index.first.find(word[0]);
-		return (i == end(_index.first)) ? 0 : i->second.size();
-	};
-	const auto best = ranges::min_element(words, std::less<>(), questions);
-	if (best == std::end(words)) {
-		return {};
-	}
-	const auto narrowed = _index.first.find((*best)[0]);
-	if (narrowed == end(_index.first)) {
+	const auto narrowed = _searchIndex.find(words);
+	if (narrowed.empty()) {
 		return {};
 	}
 	using Id = TemplatesIndex::Id;
@@ -727,7 +712,9 @@ auto Templates::query(const QString &text) const -> std::vector<Question> {
 			return (a.first.second < b.first.second);
 		}
 	};
-	const auto good = narrowed->second | ranges::views::transform(
+	const auto good = narrowed | ranges::views::transform([&](int index) {
+		return _searchIds[index];
+	}) | ranges::views::transform(
 		pairById
 	) | ranges::views::filter([](const Pair &pair) {
 		return pair.second > 0;
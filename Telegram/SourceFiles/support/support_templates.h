@@ -8,6 +8,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #pragma once
 
 #include "base/binary_guard.h"
+#include "data/data_search_index.h"
 
 #include <QtNetwork/QNetworkReply>
 
@@ -38,7 +39,6 @@ struct TemplatesIndex {
 	using Id = std::pair<QString, QString>; // filename, normalized question
 	using Term = std::pair<QString, int>; // search term, weight
 
-	std::map<QChar, std::vector<Id>> first;
 	std::map<Id, std::vector<Term>> full;
 };
 
@@ -78,11 +78,14 @@ private:
 	void updateRequestFinished(QNetworkReply *reply);
 	void checkUpdateFinished();
 	void setData(details::TemplatesData &&data);
+	void refreshSearchIndex();
 
 	not_null<Main::Session*> _session;
 
 	details::TemplatesData _data;
 	details::TemplatesIndex _index;
+	std::vector<details::TemplatesIndex::Id> _searchIds;
+	Data::SearchIndex<int> _searchIndex;
 	rpl::event_stream<QStringList> _errors;
 	base::binary_guard _reading;
 	bool _reloadAfterRead = false;
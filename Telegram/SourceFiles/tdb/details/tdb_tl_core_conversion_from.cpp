@@ -7,9 +7,49 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 */
 #include "tdb/details/tdb_tl_core_conversion_from.h"
 
+#include <array>
+
 namespace Tdb {
+namespace {
+
+constexpr auto kInternMaxLength = 32;
+constexpr auto kInternSets = 1024;
+
+// Short strings like usernames, mime types, emoji or language codes
+// repeat in almost every update, share a single QString for each of them.
+//
+// The cache is a fixed table of sets with two entries each, the least
+// recently used entry of a set is replaced. Unique strings evict only one
+// entry, and the keys reuse their buffers, so a miss allocates only the
+// QString, as it would be allocated without the cache.
+[[nodiscard]] QString Interned(const std::string &value) {
+	struct Entry {
+		std::string key;
+		QString value;
+	};
+	using Set = std::array<Entry, 2>;
+	thread_local auto cache = std::vector<Set>(kInternSets);
+
+	auto &set = cache[std::hash<std::string>()(value) % kInternSets];
+	if (set[0].key == value) {
+		return set[0].value;
+	}
+	std::swap(set[0], set[1]);
+	if (set[0].key != value) {
+		set[0].key.assign(value);
+		set[0].value = QString::fromStdString(value);
+	}
+	return set[0].value;
+}
+
+} // namespace
 
 TLstring tl_from_string(const std::string &value) {
+	if (value.empty()) {
+		return tl_string();
+	} else if (value.size() <= kInternMaxLength) {
+		return tl_string(Interned(value));
+	}
 	return tl_string(value);
 }
 
@@ -8,6 +8,11 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "tdb/tdb_sender.h"
 
 namespace Tdb {
+namespace {
+
+Sender::RequestHooks Hooks;
+
+} // namespace
 
 Sender::RequestBuilder::RequestBuilder(
 	not_null<Sender*> sender,
@@ -53,8 +58,15 @@ Sender::Sender(Sender &other) noexcept
 : Sender(other._instance) {
 }
 
-void Sender::senderRequestRegister(RequestId requestId) {
+void Sender::SetRequestHooks(RequestHooks hooks) {
+	Hooks = hooks;
+}
+
+void Sender::senderRequestRegister(RequestId requestId, uint32 type) {
 	_requests.emplace(_instance, requestId);
+	if (Hooks.sent) {
+		Hooks.sent(_instance, requestId, type);
+	}
 }
 
 void Sender::senderRequestHandled(RequestId requestId) {
@@ -62,6 +74,9 @@ void Sender::senderRequestHandled(RequestId requestId) {
 	if (i != end(_requests)) {
 		i->handled();
 		_requests.erase(i);
+		if (Hooks.finished) {
+			Hooks.finished(_instance, requestId);
+		}
 	}
 }
 
@@ -69,11 +84,17 @@ void Sender::senderRequestCancel(RequestId requestId) {
 	const auto i = _requests.find(requestId);
 	if (i != end(_requests)) {
 		_requests.erase(i);
+		if (Hooks.finished) {
+			Hooks.finished(_instance, requestId);
+		}
 	}
 }
 
 void Sender::requestCancellingDiscard() noexcept {
 	for (auto &request : base::take(_requests)) {
+		if (Hooks.finished) {
+			Hooks.finished(_instance, request.id());
+		}
 		request.handled();
 	}
 }
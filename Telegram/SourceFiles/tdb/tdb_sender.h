@@ -179,12 +179,13 @@ public:
 
 		RequestId send() noexcept {
 			const auto id = requestId();
+			const auto type = _request.type();
 			sender()->_instance->send(
 				id,
 				std::move(_request),
 				std::move(_done),
 				takeOnFail());
-			sender()->senderRequestRegister(id);
+			sender()->senderRequestRegister(id, type);
 			return id;
 		}
 
@@ -233,6 +234,18 @@ public:
 		return _instance->allocateRequestId();
 	}
 
+	// Lets the app trace requests, the hooks are called on main thread.
+	struct RequestHooks {
+		void(*sent)(
+			not_null<details::Instance*> instance,
+			RequestId requestId,
+			uint32 type) = nullptr;
+		void(*finished)(
+			not_null<details::Instance*> instance,
+			RequestId requestId) = nullptr;
+	};
+	static void SetRequestHooks(RequestHooks hooks);
+
 private:
 	class RequestWrap {
 	public:
@@ -290,7 +303,7 @@ private:
 	friend class RequestWrap;
 	friend class SentRequestWrap;
 
-	void senderRequestRegister(RequestId requestId);
+	void senderRequestRegister(RequestId requestId, uint32 type);
 	void senderRequestHandled(RequestId requestId);
 	void senderRequestCancel(RequestId requestId);
 
@@ -0,0 +1,56 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "ui/paint_stats.h"
+
+namespace Ui {
+namespace {
+
+constexpr auto kLogInterval = 5 * crl::time(1000);
+
+} // namespace
+
+PaintStats::PaintStats(const char *name) : _name(name) {
+}
+
+crl::profile_time PaintStats::start() const {
+	return Logs::DebugEnabled() ? crl::profile() : crl::profile_time();
+}
+
+void PaintStats::finish(
+		crl::profile_time started,
+		int elements,
+		QRect painted) {
+	if (!started) {
+		return;
+	}
+	const auto duration = crl::profile() - started;
+	const auto now = crl::now();
+	if (!_frames) {
+		_started = now;
+	}
+	++_frames;
+	_elements += elements;
+	_pixels += int64(painted.width()) * painted.height();
+	_total += duration;
+	_max = std::max(_max, duration);
+	if (now - _started < kLogInterval) {
+		return;
+	}
+	DEBUG_LOG(("%1 Paint: %2 frames, %3 elements, %4 Mpx, "
+		"%5 us average, %6 us max."
+		).arg(_name
+		).arg(_frames
+		).arg(_elements
+		).arg(_pixels / 1000000.
+		).arg(_total / _frames
+		).arg(_max));
+	_frames = _elements = 0;
+	_pixels = _total = _max = 0;
+}
+
+} // namespace Ui
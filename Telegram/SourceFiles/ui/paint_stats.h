@@ -0,0 +1,32 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+namespace Ui {
+
+// Accumulates paintEvent() durations of a widget while debug logs
+// are enabled and writes a summary to them once in a few seconds.
+class PaintStats final {
+public:
+	explicit PaintStats(const char *name);
+
+	[[nodiscard]] crl::profile_time start() const;
+	void finish(crl::profile_time started, int elements, QRect painted);
+
+private:
+	const char *_name = nullptr;
+	crl::time _started = 0;
+	crl::profile_time _total = 0;
+	crl::profile_time _max = 0;
+	int64 _pixels = 0;
+	int _frames = 0;
+	int _elements = 0;
+
+};
+
+} // namespace Ui
@@ -48,6 +48,11 @@ namespace Notifications {
 namespace Default {
 namespace {
 
+// New messages in the same thread replace the text of a notification
+// instead of showing another one if it was updated not long ago.
+constexpr auto kCoalesceTimeout = crl::time(3000);
+constexpr auto kMaxCacheImages = 4;
+
 [[nodiscard]] QPoint notificationStartPosition() {
 	const auto corner = Core::App().settings().notificationsCorner();
 	const auto window = Core::App().activePrimaryWindow();
@@ -116,6 +121,45 @@ QPixmap Manager::hiddenUserpicPlaceholder() const {
 	return _hiddenUserpicPlaceholder;
 }
 
+Ui::PeerUserpicView &Manager::userpicView(not_null<PeerData*> peer) {
+	auto i = _userpicViews.find(peer);
+	if (i == end(_userpicViews)) {
+		i = _userpicViews.emplace(peer, peer->createUserpicView()).first;
+	}
+	return i->second;
+}
+
+QImage Manager::takeCacheImage(QSize size) {
+	for (auto i = begin(_cacheImages); i != end(_cacheImages); ++i) {
+		if (i->size() == size) {
+			auto result = std::move(*i);
+			_cacheImages.erase(i);
+			return result;
+		}
+	}
+	return QImage(size, QImage::Format_ARGB32_Premultiplied);
+}
+
+void Manager::returnCacheImage(QImage &&image) {
+	if (!image.isNull()
+		&& image.isDetached()
+		&& _cacheImages.size() < kMaxCacheImages) {
+		_cacheImages.push_back(std::move(image));
+	}
+}
+
+QPixmap Manager::actionsCache(QSize size, Fn<QPixmap()> generate) {
+	const auto paletteVersion = style::PaletteVersion();
+	if (_actionsCache.isNull()
+		|| _actionsCacheSize != size
+		|| _actionsCachePaletteVersion != paletteVersion) {
+		_actionsCache = generate();
+		_actionsCacheSize = size;
+		_actionsCachePaletteVersion = paletteVersion;
+	}
+	return _actionsCache;
+}
+
 bool Manager::hasReplyingNotification() const {
 	for (const auto &notification : _notifications) {
 		if (notification->isReplying()) {
@@ -360,13 +404,49 @@ void Manager::removeWidget(internal::Widget *remove) {
 		}
 	}
 	showNextFromQueue();
+	if (_notifications.empty()) {
+		_userpicViews.clear();
+	}
 }
 
 void Manager::doShowNotification(NotificationFields &&fields) {
-	_queuedNotifications.emplace_back(std::move(fields));
+	auto queued = QueuedNotification(std::move(fields));
+	if (!coalesceNotification(queued)) {
+		_queuedNotifications.push_back(std::move(queued));
+	}
 	showNextFromQueue();
 }
 
+bool Manager::coalesceNotification(const QueuedNotification &queued) {
+	const auto plain = [](const QueuedNotification &queued) {
+		return queued.item
+			&& queued.reaction.empty()
+			&& !queued.fromScheduled;
+	};
+	if (!plain(queued)) {
+		return false;
+	}
+	for (auto &waiting : _queuedNotifications) {
+		if (waiting.history == queued.history
+			&& waiting.topicRootId == queued.topicRootId
+			&& plain(waiting)) {
+			waiting.item = queued.item;
+			waiting.author = queued.author;
+			return true;
+		}
+	}
+	for (const auto &notification : _notifications) {
+		if (notification->coalesce(
+				queued.history,
+				queued.topicRootId,
+				queued.item,
+				queued.author)) {
+			return true;
+		}
+	}
+	return false;
+}
+
 void Manager::doClearAll() {
 	_queuedNotifications.clear();
 	for (const auto &notification : _notifications) {
@@ -379,6 +459,7 @@ void Manager::doClearAllFast() {
 	_queuedNotifications.clear();
 	base::take(_notifications);
 	base::take(_hideAll);
+	_userpicViews.clear();
 }
 
 void Manager::doClearFromTopic(not_null<Data::ForumTopic*> topic) {
@@ -428,6 +509,13 @@ void Manager::doClearFromSession(not_null<Main::Session*> session) {
 			_positionsOutdated = true;
 		}
 	}
+	for (auto i = begin(_userpicViews); i != end(_userpicViews);) {
+		if (&i->first->session() == session) {
+			i = _userpicViews.erase(i);
+		} else {
+			++i;
+		}
+	}
 	showNextFromQueue();
 }
 
@@ -641,10 +729,10 @@ Notification::Notification(
 : Widget(manager, startPosition, shift, shiftDirection)
 , _peer(peer)
 , _started(crl::now())
+, _updated(_started)
 , _history(history)
 , _topic(history->peer->forumTopicFor(topicRootId))
 , _topicRootId(topicRootId)
-, _userpicView(_peer->createUserpicView())
 , _author(author)
 , _reaction(reaction)
 , _item(item)
@@ -667,7 +755,8 @@ Notification::Notification(
 	auto position = computePosition(st::notifyMinHeight);
 	updateGeometry(position.x(), position.y(), st::notifyWidth, st::notifyMinHeight);
 
-	_userpicLoaded = !Ui::PeerUserpicLoading(_userpicView);
+	_userpicLoaded = !Ui::PeerUserpicLoading(
+		manager->userpicView(_peer));
 	updateNotifyDisplay();
 
 	_hideTimer.setSingleShot(true);
@@ -704,6 +793,35 @@ Notification::Notification(
 	show();
 }
 
+Notification::~Notification() {
+	manager()->returnCacheImage(base::take(_cache));
+}
+
+bool Notification::coalesce(
+		not_null<History*> history,
+		MsgId topicRootId,
+		not_null<HistoryItem*> item,
+		const QString &author) {
+	if (_history != history
+		|| _topicRootId != topicRootId
+		|| !_item
+		|| !_reaction.empty()
+		|| _fromScheduled
+		|| _replyArea
+		|| isHiding()
+		|| (crl::now() - _updated > kCoalesceTimeout)) {
+		return false;
+	}
+	_item = item;
+	_author = author;
+	_updated = crl::now();
+	updateNotifyDisplay();
+	if (_hideTimer.isActive()) {
+		_hideTimer.start();
+	}
+	return true;
+}
+
 void Notification::updateReplyGeometry() {
 	_reply->moveToRight(_replyPadding, height() - _reply->height() - _replyPadding);
 }
@@ -713,22 +831,27 @@ void Notification::refreshLang() {
 }
 
 void Notification::prepareActionsCache() {
-	auto replyCache = Ui::GrabWidget(_reply);
 	auto fadeWidth = st::notifyFadeRight.width();
 	auto actionsTop = st::notifyTextTop + st::semiboldFont->height;
 	auto replyRight = _replyPadding - st::notifyBorderWidth;
 	auto actionsCacheWidth = _reply->width() + replyRight + fadeWidth;
 	auto actionsCacheHeight = height() - actionsTop - st::notifyBorderWidth;
-	auto actionsCacheImg = QImage(QSize(actionsCacheWidth, actionsCacheHeight) * cIntRetinaFactor(), QImage::Format_ARGB32_Premultiplied);
-	actionsCacheImg.setDevicePixelRatio(cRetinaFactor());
-	actionsCacheImg.fill(Qt::transparent);
-	{
-		Painter p(&actionsCacheImg);
-		st::notifyFadeRight.fill(p, style::rtlrect(0, 0, fadeWidth, actionsCacheHeight, actionsCacheWidth));
-		p.fillRect(style::rtlrect(fadeWidth, 0, actionsCacheWidth - fadeWidth, actionsCacheHeight, actionsCacheWidth), st::notificationBg);
-		p.drawPixmapRight(replyRight, _reply->y() - actionsTop, actionsCacheWidth, replyCache);
-	}
-	_buttonsCache = Ui::PixmapFromImage(std::move(actionsCacheImg));
+	const auto generate = [&] {
+		auto actionsCacheImg = QImage(QSize(actionsCacheWidth, actionsCacheHeight) * cIntRetinaFactor(), QImage::Format_ARGB32_Premultiplied);
+		actionsCacheImg.setDevicePixelRatio(cRetinaFactor());
+		actionsCacheImg.fill(Qt::transparent);
+		{
+			auto replyCache = Ui::GrabWidget(_reply);
+			Painter p(&actionsCacheImg);
+			st::notifyFadeRight.fill(p, style::rtlrect(0, 0, fadeWidth, actionsCacheHeight, actionsCacheWidth));
+			p.fillRect(style::rtlrect(fadeWidth, 0, actionsCacheWidth - fadeWidth, actionsCacheHeight, actionsCacheWidth), st::notificationBg);
+			p.drawPixmapRight(replyRight, _reply->y() - actionsTop, actionsCacheWidth, replyCache);
+		}
+		return Ui::PixmapFromImage(std::move(actionsCacheImg));
+	};
+	_buttonsCache = manager()->actionsCache(
+		QSize(actionsCacheWidth, actionsCacheHeight),
+		generate);
 }
 
 bool Notification::checkLastInput(
@@ -862,7 +985,7 @@ void Notification::updateNotifyDisplay() {
 	_hideReplyButton = options.hideReplyButton;
 
 	int32 w = width(), h = height();
-	QImage img(w * cIntRetinaFactor(), h * cIntRetinaFactor(), QImage::Format_ARGB32_Premultiplied);
+	auto img = manager()->takeCacheImage(QSize(w, h) * cIntRetinaFactor());
 	img.setDevicePixelRatio(cRetinaFactor());
 	img.fill(st::notificationBg->c);
 
@@ -881,9 +1004,9 @@ void Notification::updateNotifyDisplay() {
 				Ui::EmptyUserpic::PaintRepliesMessages(p, st::notifyPhotoPos.x(), st::notifyPhotoPos.y(), width(), st::notifyPhotoSize);
 				_userpicLoaded = true;
 			} else {
-				_userpicView = _history->peer->createUserpicView();
+				auto &view = manager()->userpicView(_history->peer);
 				_history->peer->loadUserpic();
-				_history->peer->paintUserpicLeft(p, _userpicView, st::notifyPhotoPos.x(), st::notifyPhotoPos.y(), width(), st::notifyPhotoSize);
+				_history->peer->paintUserpicLeft(p, view, st::notifyPhotoPos.x(), st::notifyPhotoPos.y(), width(), st::notifyPhotoSize);
 			}
 		} else {
 			p.drawPixmap(st::notifyPhotoPos.x(), st::notifyPhotoPos.y(), manager()->hiddenUserpicPlaceholder());
@@ -1006,6 +1129,7 @@ void Notification::updateNotifyDisplay() {
 		paintTitle(p);
 	}
 
+	manager()->returnCacheImage(base::take(_cache));
 	_cache = std::move(img);
 	if (!canReply()) {
 		toggleActionButtons(false);
@@ -1017,8 +1141,8 @@ void Notification::updatePeerPhoto() {
 	if (_userpicLoaded) {
 		return;
 	}
-	_userpicView = _peer->createUserpicView();
-	if (Ui::PeerUserpicLoading(_userpicView)) {
+	auto &view = manager()->userpicView(_peer);
+	if (Ui::PeerUserpicLoading(view)) {
 		return;
 	}
 	_userpicLoaded = true;
@@ -1033,12 +1157,11 @@ void Notification::updatePeerPhoto() {
 		st::notificationBg);
 	_peer->paintUserpicLeft(
 		p,
-		_userpicView,
+		view,
 		st::notifyPhotoPos.x(),
 		st::notifyPhotoPos.y(),
 		width(),
 		st::notifyPhotoSize);
-	_userpicView = {};
 	update();
 }
 
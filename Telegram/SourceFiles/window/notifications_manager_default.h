@@ -64,6 +64,10 @@ private:
 	};
 
 	[[nodiscard]] QPixmap hiddenUserpicPlaceholder() const;
+	[[nodiscard]] Ui::PeerUserpicView &userpicView(not_null<PeerData*> peer);
+	[[nodiscard]] QImage takeCacheImage(QSize size);
+	void returnCacheImage(QImage &&image);
+	[[nodiscard]] QPixmap actionsCache(QSize size, Fn<QPixmap()> generate);
 
 	void doUpdateAll() override;
 	void doShowNotification(NotificationFields &&fields) override;
@@ -120,6 +124,18 @@ private:
 	};
 	std::deque<QueuedNotification> _queuedNotifications;
 
+	bool coalesceNotification(const QueuedNotification &queued);
+
+	// Shared by all the notifications, so that a burst of messages
+	// doesn't prepare the same userpics and the same buttons again.
+	base::flat_map<
+		not_null<PeerData*>,
+		Ui::PeerUserpicView> _userpicViews;
+	std::vector<QImage> _cacheImages;
+	QPixmap _actionsCache;
+	QSize _actionsCacheSize;
+	int _actionsCachePaletteVersion = 0;
+
 	Ui::Animations::Simple _demoMasterOpacity;
 	bool _demoIsShown = false;
 
@@ -146,6 +162,9 @@ public:
 	bool isShowing() const {
 		return _a_opacity.animating() && !_hiding;
 	}
+	bool isHiding() const {
+		return _hiding;
+	}
 
 	void updateOpacity();
 	void changeShift(int top);
@@ -214,6 +233,7 @@ public:
 		QPoint startPosition,
 		int shift,
 		Direction shiftDirection);
+	~Notification();
 
 	void startHiding();
 	void stopHiding();
@@ -232,6 +252,11 @@ public:
 	}
 
 	// Called only by Manager.
+	bool coalesce(
+		not_null<History*> history,
+		MsgId topicRootId,
+		not_null<HistoryItem*> item,
+		const QString &author);
 	bool unlinkItem(HistoryItem *del);
 	bool unlinkHistory(History *history = nullptr, MsgId topicRootId = 0);
 	bool unlinkSession(not_null<Main::Session*> session);
@@ -283,11 +308,11 @@ private:
 	QPixmap _buttonsCache;
 
 	crl::time _started;
+	crl::time _updated;
 
 	History *_history = nullptr;
 	Data::ForumTopic *_topic = nullptr;
 	MsgId _topicRootId = 0;
-	Ui::PeerUserpicView _userpicView;
 	QString _author;
 	Data::ReactionId _reaction;
 	HistoryItem *_item = nullptr;
@@ -61,18 +61,6 @@ public:
 	const base::flat_set<QString> &searchWords() const {
 		return _searchWords;
 	}
-	bool searchWordsContain(const QString &needle) const {
-		for (const auto &word : _searchWords) {
-			if (word.startsWith(needle)) {
-				return true;
-			}
-		}
-		return false;
-	}
-
-	const base::flat_set<QChar> &searchStartChars() const {
-		return _searchStartChars;
-	}
 
 	void setTop(int top) {
 		_top = top;
@@ -110,7 +98,6 @@ private:
 	Ui::Text::String _description = { st::windowMinWidth / 2 };
 
 	base::flat_set<QString> _searchWords;
-	base::flat_set<QChar> _searchStartChars;
 
 	int _top = 0;
 	int _height = 0;
@@ -156,7 +143,6 @@ void EditorBlock::Row::fillValueString() {
 
 void EditorBlock::Row::fillSearchIndex() {
 	_searchWords.clear();
-	_searchStartChars.clear();
 	const auto toIndex = _name
 		+ ' ' + _copyOf
 		+ ' ' + TextUtilities::RemoveAccents(_description.toString())
@@ -166,7 +152,6 @@ void EditorBlock::Row::fillSearchIndex() {
 		Qt::SkipEmptyParts);
 	for (const auto &word : words) {
 		_searchWords.emplace(word);
-		_searchStartChars.emplace(word[0]);
 	}
 }
 
@@ -273,10 +258,7 @@ void EditorBlock::addToSearch(const Row &row) {
 	auto query = _searchQuery;
 	if (!query.isEmpty()) resetSearch();
 
-	auto index = findRowIndex(&row);
-	for (const auto &ch : row.searchStartChars()) {
-		_searchIndex[ch].insert(index);
-	}
+	_searchIndex.add(findRowIndex(&row), row.searchWords());
 
 	if (!query.isEmpty()) searchByQuery(query);
 }
@@ -285,16 +267,7 @@ void EditorBlock::removeFromSearch(const Row &row) {
 	auto query = _searchQuery;
 	if (!query.isEmpty()) resetSearch();
 
-	auto index = findRowIndex(&row);
-	for (const auto &ch : row.searchStartChars()) {
-		const auto i = _searchIndex.find(ch);
-		if (i != end(_searchIndex)) {
-			i->second.remove(index);
-			if (i->second.empty()) {
-				_searchIndex.erase(i);
-			}
-		}
-	}
+	_searchIndex.remove(findRowIndex(&row));
 
 	if (!query.isEmpty()) searchByQuery(query);
 }
@@ -393,35 +366,8 @@ void EditorBlock::searchByQuery(QString query) {
 		setPressed(-1);
 
 		_searchQuery = query;
-		_searchResults.clear();
-
-		auto toFilter = (base::flat_set<int>*)nullptr;
-		for (const auto &word : words) {
-			if (word.isEmpty()) continue;
-
-			const auto i = _searchIndex.find(word[0]);
-			if (i == end(_searchIndex) || i->second.empty()) {
-				toFilter = nullptr;
-				break;
-			} else if (!toFilter || i->second.size() < toFilter->size()) {
-				toFilter = &i->second;
-			}
-		}
-		if (toFilter) {
-			const auto allWordsFound = [&](const Row &row) {
-				for (const auto &word : words) {
-					if (!row.searchWordsContain(word)) {
-						return false;
-					}
-				}
-				return true;
-			};
-			for (const auto index : *toFilter) {
-				if (allWordsFound(_data[index])) {
-					_searchResults.push_back(index);
-				}
-			}
-		}
+		_searchResults = _searchIndex.find(words);
+		ranges::sort(_searchResults);
 
 		_context->resized.fire({});
 	}
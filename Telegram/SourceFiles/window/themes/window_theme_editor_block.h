@@ -8,6 +8,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #pragma once
 
 #include "ui/rp_widget.h"
+#include "data/data_search_index.h"
 
 namespace Ui {
 class BoxContent;
@@ -152,7 +153,7 @@ private:
 
 	QString _searchQuery;
 	std::vector<int> _searchResults;
-	base::flat_map<QChar, base::flat_set<int>> _searchIndex;
+	Data::SearchIndex<int> _searchIndex;
 
 	int _selected = -1;
 	int _pressed = -1;
@@ -38,6 +38,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_document_media.h"
 #include "data/data_changes.h"
 #include "data/data_group_call.h"
+#include "data/data_histories.h"
 #include "data/data_forum.h"
 #include "data/data_forum_topic.h"
 #include "data/data_chat_filters.h"
@@ -1614,8 +1615,12 @@ void SessionController::setActiveChatEntry(Dialogs::RowDescriptor row) {
 		_activeHistoryLifetime.destroy();
 		was->setFakeUnreadWhileOpened(false);
 		_invitePeekTimer.cancel();
+		session().data().histories().historyClosed(was);
 	}
 	_activeChatEntry = row;
+	if (now && now != was) {
+		session().data().histories().historyOpened(now);
+	}
 	if (now) {
 		now->setFakeUnreadWhileOpened(true);
 		if (const auto channel = now->peer->asChannel()
@@ -2978,6 +2983,9 @@ std::shared_ptr<ChatHelpers::Show> SessionController::uiShow() {
 
 SessionController::~SessionController() {
 	resetFakeUnreadWhileOpened();
+	if (const auto history = _activeChatEntry.current().key.history()) {
+		session().data().histories().historyClosed(history);
+	}
 }
 
 } // namespace Window
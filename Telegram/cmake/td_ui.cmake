@@ -130,6 +130,8 @@ PRIVATE
     media/clip/media_clip_check_streaming.h
     media/clip/media_clip_ffmpeg.cpp
     media/clip/media_clip_ffmpeg.h
+    media/clip/media_clip_frames_cache.cpp
+    media/clip/media_clip_frames_cache.h
     media/clip/media_clip_implementation.cpp
     media/clip/media_clip_implementation.h
     media/clip/media_clip_reader.cpp
@@ -415,4 +417,5 @@ PRIVATE
     desktop-app::lib_spellcheck
     desktop-app::lib_stripe
     desktop-app::external_kcoreaddons
+    desktop-app::external_xxhash
 )